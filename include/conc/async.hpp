@@ -0,0 +1,206 @@
+#pragma once
+
+#include <conc/concurrency.hpp>
+
+#include <concepts>
+#include <coroutine>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace conc {
+// An executor resumes a coroutine that has been handed a lock
+template <typename T>
+concept executor = std::invocable<T &, std::coroutine_handle<>>;
+
+// resumes a coroutine on the thread that hands it the lock, on top of the
+// releasing coroutine's stack: each waiter handed the lock in turn nests one
+// level deeper, so long queues need an executor that defers resumption
+struct inline_executor {
+    auto operator()(std::coroutine_handle<> h) const -> void { h.resume(); }
+};
+
+namespace detail {
+struct async_waiter {
+    async_waiter *next{};
+    std::coroutine_handle<> handle{};
+    // called under the queue's critical section; nullptr means always ready
+    bool (*ready)(async_waiter &){};
+    void (*schedule)(async_waiter &){};
+};
+
+// Each Tag identifies an asynchronous lock: a flag and a FIFO queue of
+// suspended waiters, both protected by the critical section async_tag<Tag>.
+template <typename Tag> struct async_tag;
+
+template <typename Tag> struct async_lock_state {
+    static inline bool locked{};
+    static inline async_waiter *head{};
+    static inline async_waiter *tail{};
+
+    static auto is_ready(async_waiter &w) -> bool {
+        return w.ready == nullptr or w.ready(w);
+    }
+
+    // true if the lock was acquired; otherwise w is queued and will be
+    // scheduled when it is handed the lock
+    static auto try_lock_or_enqueue(async_waiter &w) -> bool {
+        return call_in_critical_section<async_tag<Tag>>([&] {
+            if (not locked and is_ready(w)) {
+                locked = true;
+                return true;
+            }
+            w.next = nullptr;
+            (tail == nullptr ? head : tail->next) = &w;
+            tail = &w;
+            return false;
+        });
+    }
+
+    // hand the lock to the first waiter that is ready, or release it
+    static auto unlock() -> void {
+        auto *const next = call_in_critical_section<async_tag<Tag>>(
+            [&]() -> async_waiter * {
+                async_waiter *prev{};
+                for (auto *w = head; w != nullptr; prev = w, w = w->next) {
+                    if (is_ready(*w)) {
+                        (prev == nullptr ? head : prev->next) = w->next;
+                        if (tail == w) {
+                            tail = prev;
+                        }
+                        return w;
+                    }
+                }
+                locked = false;
+                return nullptr;
+            });
+        if (next != nullptr) {
+            next->schedule(*next);
+        }
+    }
+};
+} // namespace detail
+
+// Ownership of the asynchronous lock identified by Tag; the lock is released
+// (and handed to the next waiter) on destruction.
+template <typename Tag> class [[nodiscard]] async_lock_guard {
+    bool owns{true};
+
+  public:
+    async_lock_guard() = default;
+    async_lock_guard(async_lock_guard const &) = delete;
+    async_lock_guard(async_lock_guard &&other) noexcept
+        : owns{std::exchange(other.owns, false)} {}
+    auto operator=(async_lock_guard const &) -> async_lock_guard & = delete;
+    auto operator=(async_lock_guard &&other) noexcept -> async_lock_guard & {
+        if (this != &other) {
+            unlock();
+            owns = std::exchange(other.owns, false);
+        }
+        return *this;
+    }
+    ~async_lock_guard() { unlock(); }
+
+    auto unlock() -> void {
+        if (std::exchange(owns, false)) {
+            detail::async_lock_state<Tag>::unlock();
+        }
+    }
+    [[nodiscard]] auto owns_lock() const -> bool { return owns; }
+};
+
+namespace detail {
+template <typename Tag, executor Executor, std::predicate... Pred>
+    requires(sizeof...(Pred) < 2)
+class [[nodiscard]] lock_awaiter : async_waiter {
+    [[no_unique_address]] Executor ex;
+    [[no_unique_address]] std::tuple<Pred...> pred;
+
+    static auto ready_fn(async_waiter &w) -> bool {
+        return std::apply([](auto &...p) { return (... and p()); },
+                          static_cast<lock_awaiter &>(w).pred);
+    }
+    static auto schedule_fn(async_waiter &w) -> void {
+        auto &self = static_cast<lock_awaiter &>(w);
+        std::invoke(self.ex, self.handle);
+    }
+
+  public:
+    template <typename E, typename... P>
+    explicit lock_awaiter(E &&e, P &&...p)
+        : ex{std::forward<E>(e)}, pred{std::forward<P>(p)...} {
+        if constexpr (sizeof...(Pred) != 0) {
+            ready = ready_fn;
+        }
+        schedule = schedule_fn;
+    }
+    lock_awaiter(lock_awaiter const &) = delete;
+    lock_awaiter(lock_awaiter &&) = delete;
+    auto operator=(lock_awaiter const &) -> lock_awaiter & = delete;
+    auto operator=(lock_awaiter &&) -> lock_awaiter & = delete;
+    ~lock_awaiter() = default;
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+    auto await_suspend(std::coroutine_handle<> h) -> bool {
+        handle = h;
+        return not async_lock_state<Tag>::try_lock_or_enqueue(*this);
+    }
+    auto await_resume() const noexcept -> async_lock_guard<Tag> { return {}; }
+};
+
+template <typename Tag, typename F, executor Executor, std::predicate... Pred>
+class [[nodiscard]] section_awaiter
+    : public lock_awaiter<Tag, Executor, Pred...> {
+    F f;
+
+  public:
+    template <typename G, typename E, typename... P>
+    section_awaiter(G &&g, E &&e, P &&...p)
+        : lock_awaiter<Tag, Executor, Pred...>{std::forward<E>(e),
+                                               std::forward<P>(p)...},
+          f{std::forward<G>(g)} {}
+
+    auto await_resume() -> std::invoke_result_t<F &&> {
+        [[maybe_unused]] auto const g =
+            lock_awaiter<Tag, Executor, Pred...>::await_resume();
+        return std::move(f)();
+    }
+};
+} // namespace detail
+
+// co_await conc::lock<Tag>() suspends the calling coroutine until it owns the
+// asynchronous lock identified by Tag, and yields an async_lock_guard<Tag>.
+// When a waiter is handed the lock, it is resumed by calling ex with its
+// coroutine handle.
+template <typename Tag, executor Executor = inline_executor>
+[[nodiscard]] auto lock(Executor &&ex = {}) {
+    return detail::lock_awaiter<Tag, std::remove_cvref_t<Executor>>{
+        std::forward<Executor>(ex)};
+}
+
+// The asynchronous analog of call_in_critical_section: co_await suspends until
+// the lock identified by Uniq is free and the predicate (if any) is true, then
+// returns the result of calling f while holding the lock. A waiting predicate
+// is re-evaluated each time the lock is released.
+template <typename Uniq = decltype([] {}), executor Executor, std::invocable F,
+          std::predicate... Pred>
+    requires(sizeof...(Pred) < 2)
+[[nodiscard]] auto call_in_critical_section_async(Executor &&ex, F &&f,
+                                                  Pred &&...pred) {
+    return detail::section_awaiter<Uniq, std::decay_t<F>,
+                                   std::remove_cvref_t<Executor>,
+                                   std::decay_t<Pred>...>{
+        std::forward<F>(f), std::forward<Executor>(ex),
+        std::forward<Pred>(pred)...};
+}
+
+template <typename Uniq = decltype([] {}), std::invocable F,
+          std::predicate... Pred>
+    requires(sizeof...(Pred) < 2)
+[[nodiscard]] auto call_in_critical_section_async(F &&f, Pred &&...pred) {
+    return call_in_critical_section_async<Uniq>(inline_executor{},
+                                                std::forward<F>(f),
+                                                std::forward<Pred>(pred)...);
+}
+} // namespace conc
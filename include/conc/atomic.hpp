@@ -4,7 +4,9 @@
 
 #include <atomic>
 #include <concepts>
+#include <cstddef>
 #include <memory>
+#include <type_traits>
 
 // NOLINTBEGIN(cppcoreguidelines-pro-type-vararg)
 
@@ -90,17 +92,134 @@ struct standard_policy {
         return __atomic_fetch_xor(std::addressof(t), value,
                                   static_cast<int>(mo));
     }
+
+    template <typename T>
+    __attribute__((always_inline, flatten)) static inline auto
+    compare_exchange_strong(T &t, T &expected, T &desired,
+                            std::memory_order success = std::memory_order_seq_cst,
+                            std::memory_order failure = std::memory_order_seq_cst)
+        -> bool {
+        return __atomic_compare_exchange(
+            std::addressof(t), std::addressof(expected),
+            std::addressof(desired), false, static_cast<int>(success),
+            static_cast<int>(failure));
+    }
+
+    template <typename T>
+    __attribute__((always_inline, flatten)) static inline auto
+    compare_exchange_weak(T &t, T &expected, T &desired,
+                          std::memory_order success = std::memory_order_seq_cst,
+                          std::memory_order failure = std::memory_order_seq_cst)
+        -> bool {
+        return __atomic_compare_exchange(
+            std::addressof(t), std::addressof(expected),
+            std::addressof(desired), true, static_cast<int>(success),
+            static_cast<int>(failure));
+    }
+
+    __attribute__((always_inline, flatten)) static inline auto
+    thread_fence(std::memory_order mo = std::memory_order_seq_cst) -> void {
+        __atomic_thread_fence(static_cast<int>(mo));
+    }
 };
+
+// the failure order std::atomic uses when only one order is given
+constexpr auto failure_order(std::memory_order mo) -> std::memory_order {
+    switch (mo) {
+    case std::memory_order_acq_rel:
+        return std::memory_order_acquire;
+    case std::memory_order_release:
+        return std::memory_order_relaxed;
+    default:
+        return mo;
+    }
+}
 } // namespace detail
 
 template <typename...> inline auto injected_policy = detail::standard_policy{};
 
+namespace detail {
+template <typename T, typename Policy>
+constexpr auto policy_is_always_lock_free() -> bool {
+    if constexpr (requires {
+                      {
+                          Policy::template is_always_lock_free<T>()
+                      } -> std::convertible_to<bool>;
+                  }) {
+        return Policy::template is_always_lock_free<T>();
+    } else {
+        // the builtin answers for the typical alignment for T's size (a
+        // non-null address is not a constant expression), which is the size
+        // itself for any lock-free size: an under-aligned T is not lock-free
+        return __atomic_always_lock_free(sizeof(T), 0) and
+               alignof(T) >= sizeof(T);
+    }
+}
+
+template <typename T, typename... Policy>
+constexpr auto always_lock_free() -> bool {
+    if constexpr (sizeof...(Policy) == 0) {
+        // with an empty pack, this is the injected policy, looked up late
+        return policy_is_always_lock_free<
+            T, std::remove_cvref_t<decltype(injected_policy<Policy...>)>>();
+    } else {
+        return (... and policy_is_always_lock_free<T, Policy>());
+    }
+}
+} // namespace detail
+
+// Whether operations on T with Policy (by default, the injected policy) never
+// fall back to a lock. A policy may answer for itself by providing
+//   template <typename T> constexpr static auto is_always_lock_free() -> bool;
+// otherwise this is the compiler's answer for an object of T with T's
+// alignment.
+template <typename T, typename... Policy>
+    requires(sizeof...(Policy) < 2)
+constexpr inline auto is_always_lock_free =
+    detail::always_lock_free<T, Policy...>();
+
+namespace detail {
+struct no_fallback_policy {};
+} // namespace detail
+
+// Operations on a type that is not always lock-free use this policy instead of
+// the injected policy, if one is provided. For example, to use critical
+// sections (see conc/atomic_fallback.hpp):
+//   template <typename T>
+//   inline auto atomic::fallback_policy<T> = atomic::critical_section_policy{};
+template <typename T, typename...>
+inline auto fallback_policy = detail::no_fallback_policy{};
+
+// When true, an operation on a type that is not always lock-free, and that has
+// no fallback policy, fails to compile. Opt in with:
+//   template <> constexpr inline auto atomic::strict_lock_free<> = true;
+template <typename...> constexpr inline auto strict_lock_free = false;
+
+namespace detail {
+template <typename T, typename... DummyArgs>
+__attribute__((always_inline)) inline auto policy_for() -> auto & {
+    using P = std::remove_cvref_t<decltype(injected_policy<DummyArgs...>)>;
+    using F = std::remove_cvref_t<decltype(fallback_policy<T, DummyArgs...>)>;
+    if constexpr (atomic::is_always_lock_free<T, P> or
+                  std::same_as<F, no_fallback_policy>) {
+        static_assert(atomic::is_always_lock_free<T, P> or
+                          not strict_lock_free<DummyArgs...>,
+                      "This atomic operation is not lock-free: provide an "
+                      "atomic::fallback_policy for this type, or do not opt "
+                      "in to atomic::strict_lock_free");
+        return injected_policy<DummyArgs...>;
+    } else {
+        return fallback_policy<T, DummyArgs...>;
+    }
+}
+} // namespace detail
+
 template <typename... DummyArgs, typename T>
     requires(sizeof...(DummyArgs) == 0)
 [[nodiscard]]
 __attribute__((always_inline, flatten)) inline auto
 load(T const &t, std::memory_order mo = std::memory_order_seq_cst) -> T {
-    load_store_policy auto &p = injected_policy<DummyArgs...>;
+    load_store_policy auto &p = detail::policy_for<T, DummyArgs...>();
     return p.load(t, mo);
 }
 
@@ -108,7 +227,7 @@ template <typename... DummyArgs, typename T, std::convertible_to<T> U>
     requires(sizeof...(DummyArgs) == 0)
 __attribute__((always_inline, flatten)) inline auto
 store(T &t, U value, std::memory_order mo = std::memory_order_seq_cst) -> void {
-    load_store_policy auto &p = injected_policy<DummyArgs...>;
+    load_store_policy auto &p = detail::policy_for<T, DummyArgs...>();
     auto v = static_cast<T>(value);
     p.store(t, v, mo);
 }
@@ -118,7 +237,7 @@ template <typename... DummyArgs, typename T, std::convertible_to<T> U>
 [[nodiscard]]
 __attribute__((always_inline, flatten)) inline auto
 exchange(T &t, U value, std::memory_order mo = std::memory_order_seq_cst) -> T {
-    exchange_policy auto &p = injected_policy<DummyArgs...>;
+    exchange_policy auto &p = detail::policy_for<T, DummyArgs...>();
     auto v = static_cast<T>(value);
     return p.exchange(t, v, mo);
 }
@@ -128,7 +247,7 @@ template <typename... DummyArgs, typename T, std::convertible_to<T> U>
 __attribute__((always_inline, flatten)) inline auto
 fetch_add(T &t, U value, std::memory_order mo = std::memory_order_seq_cst)
     -> T {
-    add_sub_policy auto &p = injected_policy<DummyArgs...>;
+    add_sub_policy auto &p = detail::policy_for<T, DummyArgs...>();
     return p.fetch_add(t, static_cast<T>(value), mo);
 }
 
@@ -137,7 +256,7 @@ template <typename... DummyArgs, typename T, std::convertible_to<T> U>
 __attribute__((always_inline, flatten)) inline auto
 fetch_sub(T &t, U value, std::memory_order mo = std::memory_order_seq_cst)
     -> T {
-    add_sub_policy auto &p = injected_policy<DummyArgs...>;
+    add_sub_policy auto &p = detail::policy_for<T, DummyArgs...>();
     return p.fetch_sub(t, static_cast<T>(value), mo);
 }
 
@@ -146,7 +265,7 @@ template <typename... DummyArgs, typename T, std::convertible_to<T> U>
 __attribute__((always_inline, flatten)) inline auto
 fetch_and(T &t, U value, std::memory_order mo = std::memory_order_seq_cst)
     -> T {
-    bitwise_policy auto &p = injected_policy<DummyArgs...>;
+    bitwise_policy auto &p = detail::policy_for<T, DummyArgs...>();
     return p.fetch_and(t, static_cast<T>(value), mo);
 }
 
@@ -154,7 +273,7 @@ template <typename... DummyArgs, typename T, std::convertible_to<T> U>
     requires(sizeof...(DummyArgs) == 0)
 __attribute__((always_inline, flatten)) inline auto
 fetch_or(T &t, U value, std::memory_order mo = std::memory_order_seq_cst) -> T {
-    bitwise_policy auto &p = injected_policy<DummyArgs...>;
+    bitwise_policy auto &p = detail::policy_for<T, DummyArgs...>();
     return p.fetch_or(t, static_cast<T>(value), mo);
 }
 
@@ -163,10 +282,58 @@ template <typename... DummyArgs, typename T, std::convertible_to<T> U>
 __attribute__((always_inline, flatten)) inline auto
 fetch_xor(T &t, U value, std::memory_order mo = std::memory_order_seq_cst)
     -> T {
-    bitwise_policy auto &p = injected_policy<DummyArgs...>;
+    bitwise_policy auto &p = detail::policy_for<T, DummyArgs...>();
     return p.fetch_xor(t, static_cast<T>(value), mo);
 }
 
+template <typename... DummyArgs, typename T, std::convertible_to<T> U>
+    requires(sizeof...(DummyArgs) == 0)
+__attribute__((always_inline, flatten)) inline auto
+compare_exchange_strong(T &t, T &expected, U desired, std::memory_order success,
+                        std::memory_order failure) -> bool {
+    compare_exchange_policy auto &p = detail::policy_for<T, DummyArgs...>();
+    auto d = static_cast<T>(desired);
+    return p.compare_exchange_strong(t, expected, d, success, failure);
+}
+
+template <typename... DummyArgs, typename T, std::convertible_to<T> U>
+    requires(sizeof...(DummyArgs) == 0)
+__attribute__((always_inline, flatten)) inline auto
+compare_exchange_strong(T &t, T &expected, U desired,
+                        std::memory_order mo = std::memory_order_seq_cst)
+    -> bool {
+    return compare_exchange_strong<DummyArgs...>(t, expected, desired, mo,
+                                                 detail::failure_order(mo));
+}
+
+template <typename... DummyArgs, typename T, std::convertible_to<T> U>
+    requires(sizeof...(DummyArgs) == 0)
+__attribute__((always_inline, flatten)) inline auto
+compare_exchange_weak(T &t, T &expected, U desired, std::memory_order success,
+                      std::memory_order failure) -> bool {
+    compare_exchange_policy auto &p = detail::policy_for<T, DummyArgs...>();
+    auto d = static_cast<T>(desired);
+    return p.compare_exchange_weak(t, expected, d, success, failure);
+}
+
+template <typename... DummyArgs, typename T, std::convertible_to<T> U>
+    requires(sizeof...(DummyArgs) == 0)
+__attribute__((always_inline, flatten)) inline auto
+compare_exchange_weak(T &t, T &expected, U desired,
+                      std::memory_order mo = std::memory_order_seq_cst)
+    -> bool {
+    return compare_exchange_weak<DummyArgs...>(t, expected, desired, mo,
+                                               detail::failure_order(mo));
+}
+
+template <typename... DummyArgs>
+    requires(sizeof...(DummyArgs) == 0)
+__attribute__((always_inline, flatten)) inline auto
+thread_fence(std::memory_order mo = std::memory_order_seq_cst) -> void {
+    fence_policy auto &p = injected_policy<DummyArgs...>;
+    p.thread_fence(mo);
+}
+
 template <typename T> struct atomic_type {
     using type = T;
 };
@@ -174,6 +341,9 @@ template <typename T> using atomic_type_t = typename atomic_type<T>::type;
 
 template <typename T>
 constexpr inline auto alignment_of = alignof(std::atomic<atomic_type_t<T>>);
+
+// used to keep independently-written data on separate cache lines
+template <typename...> constexpr inline auto cache_line_size = std::size_t{64};
 } // namespace atomic
 
 // NOLINTEND(cppcoreguidelines-pro-type-vararg)
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+#include <conc/concurrency.hpp>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace atomic {
+namespace detail {
+template <typename Tag, typename T> struct fallback_tag;
+} // namespace detail
+
+// An atomic policy that performs each operation inside a conc critical section,
+// with one critical section for each type (and Tag). Use it as the
+// atomic::fallback_policy for types that are not always lock-free, so that
+// they use the platform's injected critical section rather than (for example)
+// the hashed global locks in libatomic.
+template <typename Tag = void> struct critical_section_policy {
+  private:
+    template <typename T, typename F>
+    static auto locked(F &&f) -> decltype(auto) {
+        return conc::call_in_critical_section<detail::fallback_tag<Tag, T>>(
+            std::forward<F>(f));
+    }
+
+  public:
+    template <typename> constexpr static auto is_always_lock_free() -> bool {
+        return false;
+    }
+
+    template <typename T>
+    static auto load(T const &t, std::memory_order = std::memory_order_seq_cst)
+        -> T {
+        return locked<T>([&] { return t; });
+    }
+
+    template <typename T>
+    static auto store(T &t, T &value,
+                      std::memory_order = std::memory_order_seq_cst) -> void {
+        locked<T>([&] { t = value; });
+    }
+
+    template <typename T>
+    static auto exchange(T &t, T &value,
+                         std::memory_order = std::memory_order_seq_cst) -> T {
+        return locked<T>([&] { return std::exchange(t, value); });
+    }
+
+    template <typename T>
+    static auto fetch_add(T &t, T value,
+                          std::memory_order = std::memory_order_seq_cst) -> T {
+        return locked<T>(
+            [&] { return std::exchange(t, static_cast<T>(t + value)); });
+    }
+
+    template <typename T>
+    static auto fetch_sub(T &t, T value,
+                          std::memory_order = std::memory_order_seq_cst) -> T {
+        return locked<T>(
+            [&] { return std::exchange(t, static_cast<T>(t - value)); });
+    }
+
+    template <typename T>
+    static auto fetch_and(T &t, T value,
+                          std::memory_order = std::memory_order_seq_cst) -> T {
+        return locked<T>(
+            [&] { return std::exchange(t, static_cast<T>(t & value)); });
+    }
+
+    template <typename T>
+    static auto fetch_or(T &t, T value,
+                         std::memory_order = std::memory_order_seq_cst) -> T {
+        return locked<T>(
+            [&] { return std::exchange(t, static_cast<T>(t | value)); });
+    }
+
+    template <typename T>
+    static auto fetch_xor(T &t, T value,
+                          std::memory_order = std::memory_order_seq_cst) -> T {
+        return locked<T>(
+            [&] { return std::exchange(t, static_cast<T>(t ^ value)); });
+    }
+
+    // as with __atomic_compare_exchange, values are compared bitwise
+    template <typename T>
+    static auto
+    compare_exchange_strong(T &t, T &expected, T &desired,
+                            std::memory_order = std::memory_order_seq_cst,
+                            std::memory_order = std::memory_order_seq_cst)
+        -> bool {
+        return locked<T>([&] {
+            if (__builtin_memcmp(std::addressof(t), std::addressof(expected),
+                                 sizeof(T)) == 0) {
+                t = desired;
+                return true;
+            }
+            expected = t;
+            return false;
+        });
+    }
+
+    template <typename T>
+    static auto
+    compare_exchange_weak(T &t, T &expected, T &desired,
+                          std::memory_order success = std::memory_order_seq_cst,
+                          std::memory_order failure = std::memory_order_seq_cst)
+        -> bool {
+        return compare_exchange_strong(t, expected, desired, success, failure);
+    }
+
+    static auto thread_fence(std::memory_order mo = std::memory_order_seq_cst)
+        -> void {
+        detail::standard_policy::thread_fence(mo);
+    }
+};
+} // namespace atomic
@@ -0,0 +1,475 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+#include <conc/detail/thread_log.hpp>
+#include <conc/detail/timestamp.hpp>
+
+#if __STDC_HOSTED__ == 0
+#error atomic::recording_policy is designed for desktop testing and requires a hosted implementation
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace atomic {
+enum struct op : std::uint8_t {
+    load,
+    store,
+    exchange,
+    fetch_add,
+    fetch_sub,
+    fetch_and,
+    fetch_or,
+    fetch_xor,
+    compare_exchange,
+    fence
+};
+
+// One atomic operation. Values are recorded as their object representation;
+// operations on types wider than 64 bits, and fences, are recorded with
+// value_size == 0. A failed compare-exchange is recorded as a load.
+struct event {
+    std::uint64_t begin{};
+    std::uint64_t end{};
+    void const *address{};
+    std::uint64_t read{};
+    std::uint64_t written{};
+    std::size_t thread{};
+    op kind{};
+    std::memory_order order{};
+    std::uint8_t value_size{};
+
+    [[nodiscard]] constexpr auto reads() const -> bool {
+        return kind != op::store and kind != op::fence;
+    }
+    [[nodiscard]] constexpr auto writes() const -> bool {
+        return kind != op::load and kind != op::fence;
+    }
+};
+
+struct recorder {
+    constexpr static auto capacity = std::size_t{1} << 16u;
+
+  private:
+    using log_t = conc::detail::thread_log<event, capacity, recorder>;
+
+  public:
+    [[nodiscard]] static auto now() -> std::uint64_t {
+        return conc::detail::steady_ns();
+    }
+
+    template <typename T>
+    [[nodiscard]] static auto bits(T const &t) -> std::uint64_t {
+        auto b = std::uint64_t{};
+        if constexpr (sizeof(T) <= sizeof(b)) {
+            std::memcpy(&b, std::addressof(t), sizeof(T));
+        }
+        return b;
+    }
+
+    template <typename T>
+    static auto record(op kind, T const &t, std::uint64_t begin,
+                       std::uint64_t read, std::uint64_t written,
+                       std::memory_order mo) -> void {
+        constexpr auto size =
+            sizeof(T) <= sizeof(std::uint64_t) ? sizeof(T) : std::size_t{};
+        log_t::append({.begin = begin,
+                       .end = now(),
+                       .address = std::addressof(t),
+                       .read = read,
+                       .written = written,
+                       .thread = log_t::thread_id(),
+                       .kind = kind,
+                       .order = mo,
+                       .value_size = static_cast<std::uint8_t>(size)});
+    }
+
+    static auto record_fence(std::uint64_t begin, std::memory_order mo)
+        -> void {
+        log_t::append({.begin = begin,
+                       .end = now(),
+                       .thread = log_t::thread_id(),
+                       .kind = op::fence,
+                       .order = mo});
+    }
+
+    // all recorded events, ordered by start time
+    [[nodiscard]] static auto collect() -> std::vector<event> {
+        std::vector<event> events{};
+        log_t::for_each([&](auto, event const &e) { events.push_back(e); });
+        std::ranges::stable_sort(events, std::less{}, &event::begin);
+        return events;
+    }
+
+    // events lost because a thread's buffer was full
+    [[nodiscard]] static auto dropped() -> std::size_t {
+        return log_t::dropped();
+    }
+
+    // only call while no thread is performing atomic operations
+    static auto reset() -> void { log_t::reset(); }
+};
+
+// An atomic policy that forwards to Base and records every operation
+template <typename Base = detail::standard_policy> struct recording_policy {
+    template <typename T>
+    static auto load(T const &t, std::memory_order mo = std::memory_order_seq_cst)
+        -> T {
+        auto const b = recorder::now();
+        auto const r = Base::load(t, mo);
+        recorder::record(op::load, t, b, recorder::bits(r), 0, mo);
+        return r;
+    }
+
+    template <typename T>
+    static auto store(T &t, T &value,
+                      std::memory_order mo = std::memory_order_seq_cst)
+        -> void {
+        auto const b = recorder::now();
+        Base::store(t, value, mo);
+        recorder::record(op::store, t, b, 0, recorder::bits(value), mo);
+    }
+
+    template <typename T>
+    static auto exchange(T &t, T &value,
+                         std::memory_order mo = std::memory_order_seq_cst)
+        -> T {
+        auto const b = recorder::now();
+        auto const r = Base::exchange(t, value, mo);
+        recorder::record(op::exchange, t, b, recorder::bits(r),
+                         recorder::bits(value), mo);
+        return r;
+    }
+
+#define ATOMIC_RECORDING_RMW(NAME, OP)                                         \
+    template <typename T>                                                      \
+    static auto NAME(T &t, T value,                                            \
+                     std::memory_order mo = std::memory_order_seq_cst) -> T {  \
+        auto const b = recorder::now();                                        \
+        auto const r = Base::NAME(t, value, mo);                               \
+        recorder::record(op::NAME, t, b, recorder::bits(r),                    \
+                         recorder::bits(static_cast<T>(r OP value)), mo);      \
+        return r;                                                              \
+    }
+
+    ATOMIC_RECORDING_RMW(fetch_add, +)
+    ATOMIC_RECORDING_RMW(fetch_sub, -)
+    ATOMIC_RECORDING_RMW(fetch_and, &)
+    ATOMIC_RECORDING_RMW(fetch_or, |)
+    ATOMIC_RECORDING_RMW(fetch_xor, ^)
+
+#undef ATOMIC_RECORDING_RMW
+
+  private:
+    template <typename T>
+    static auto record_compare_exchange(bool success, T const &t,
+                                        std::uint64_t b, T const &expected,
+                                        T const &desired,
+                                        std::memory_order success_mo,
+                                        std::memory_order failure_mo) -> void {
+        if (success) {
+            recorder::record(op::compare_exchange, t, b,
+                             recorder::bits(expected), recorder::bits(desired),
+                             success_mo);
+        } else {
+            recorder::record(op::load, t, b, recorder::bits(expected), 0,
+                             failure_mo);
+        }
+    }
+
+  public:
+    template <typename T>
+    static auto
+    compare_exchange_strong(T &t, T &expected, T &desired,
+                            std::memory_order success = std::memory_order_seq_cst,
+                            std::memory_order failure = std::memory_order_seq_cst)
+        -> bool {
+        auto const b = recorder::now();
+        auto const r = Base::compare_exchange_strong(t, expected, desired,
+                                                     success, failure);
+        record_compare_exchange(r, t, b, expected, desired, success, failure);
+        return r;
+    }
+
+    template <typename T>
+    static auto
+    compare_exchange_weak(T &t, T &expected, T &desired,
+                          std::memory_order success = std::memory_order_seq_cst,
+                          std::memory_order failure = std::memory_order_seq_cst)
+        -> bool {
+        auto const b = recorder::now();
+        auto const r = Base::compare_exchange_weak(t, expected, desired,
+                                                   success, failure);
+        record_compare_exchange(r, t, b, expected, desired, success, failure);
+        return r;
+    }
+
+    static auto thread_fence(std::memory_order mo = std::memory_order_seq_cst)
+        -> void {
+        auto const b = recorder::now();
+        Base::thread_fence(mo);
+        recorder::record_fence(b, mo);
+    }
+};
+
+// The sequential specification of a memory location: every read returns the
+// last value written. The initial value is taken from the first operation.
+struct location_spec {
+    using state_type = std::optional<std::uint64_t>;
+
+    [[nodiscard]] static auto initial() -> state_type { return {}; }
+
+    static auto apply(state_type &s, event const &e) -> bool {
+        if (e.reads()) {
+            if (s and *s != e.read) {
+                return false;
+            }
+            s = e.read;
+        }
+        if (e.writes()) {
+            s = e.written;
+        }
+        return true;
+    }
+};
+
+template <typename Spec>
+concept sequential_spec = requires {
+    { Spec::initial() } -> std::convertible_to<typename Spec::state_type>;
+    requires std::totally_ordered<typename Spec::state_type>;
+};
+
+// Wing & Gong linearizability search: is there a total order of the
+// operations, consistent with their [begin, end] intervals, that Spec
+// accepts? Exponential in the worst case; intended for short histories.
+template <sequential_spec Spec, std::ranges::random_access_range R>
+[[nodiscard]] auto is_linearizable(R const &ops, Spec const &spec = {})
+    -> bool {
+    using state_t = typename Spec::state_type;
+    auto const history = std::span{ops};
+    auto const n = history.size();
+    std::vector<bool> done(n);
+    std::set<std::pair<std::vector<bool>, state_t>> seen{};
+
+    auto const search = [&](auto &self, state_t const &s,
+                            std::size_t count) -> bool {
+        if (count == n) {
+            return true;
+        }
+        if (not seen.emplace(done, s).second) {
+            return false;
+        }
+        auto min_end = std::numeric_limits<std::uint64_t>::max();
+        for (auto i = std::size_t{}; i < n; ++i) {
+            if (not done[i]) {
+                min_end = std::min<std::uint64_t>(min_end, history[i].end);
+            }
+        }
+        for (auto i = std::size_t{}; i < n; ++i) {
+            if (done[i] or history[i].begin > min_end) {
+                continue;
+            }
+            auto next = s;
+            if (spec.apply(next, history[i])) {
+                done[i] = true;
+                if (self(self, next, count + 1)) {
+                    return true;
+                }
+                done[i] = false;
+            }
+        }
+        return false;
+    };
+    return search(search, Spec::initial(), 0);
+}
+
+struct violation {
+    enum struct kind : std::uint8_t {
+        // a read returned a value that no write produced
+        unwritten_value,
+        // a thread read a value older than its own last write
+        coherence,
+        // an acquire read synchronized only with relaxed writes (not
+        // preceded by a release fence, nor read-modify-writes continuing a
+        // release sequence). This is a heuristic, not a bug by itself (e.g. a
+        // relaxed counter read with acquire), so it is only reported if
+        // check_options::missing_release is set.
+        missing_release,
+        // the operations on a location have no valid sequential order
+        not_linearizable
+    };
+    kind what{};
+    event e{};
+};
+
+struct check_options {
+    // linearizability is only checked for locations with at most this many
+    // operations
+    std::size_t linearizability_limit{64};
+    // report acquire reads that synchronize only with relaxed writes
+    bool missing_release{};
+};
+
+namespace detail {
+[[nodiscard]] constexpr auto is_acquire(std::memory_order mo) -> bool {
+    return mo == std::memory_order_acquire or
+           mo == std::memory_order_acq_rel or
+           mo == std::memory_order_seq_cst or
+           mo == std::memory_order_consume;
+}
+
+[[nodiscard]] constexpr auto is_release(std::memory_order mo) -> bool {
+    return mo == std::memory_order_release or
+           mo == std::memory_order_acq_rel or
+           mo == std::memory_order_seq_cst;
+}
+
+// thread -> end of its first release fence
+using release_fences_t = std::map<std::size_t, std::uint64_t>;
+
+inline auto check_location(std::span<event const> events,
+                           release_fences_t const &release_fences,
+                           check_options const &options,
+                           std::vector<violation> &violations) -> void {
+    auto const releases = [&](event const &w) {
+        if (is_release(w.order)) {
+            return true;
+        }
+        auto const it = release_fences.find(w.thread);
+        return it != std::end(release_fences) and it->second <= w.begin;
+    };
+
+    // the initial value is witnessed by a read that starts before any write
+    auto const first_write = std::ranges::find_if(events, &event::writes);
+    std::optional<std::uint64_t> initial{};
+    for (auto it = std::begin(events); it != first_write; ++it) {
+        if (it->reads()) {
+            initial = it->read;
+            break;
+        }
+    }
+
+    std::map<std::uint64_t, std::vector<event const *>> writes_of{};
+    for (auto const &w : events) {
+        if (w.writes()) {
+            writes_of[w.written].push_back(&w);
+        }
+    }
+
+    // true if w is in a release sequence: it is a release write, or a
+    // read-modify-write that read from a write in a release sequence
+    auto const in_release_sequence = [&](event const &w) {
+        auto pending = std::vector<event const *>{&w};
+        auto seen = std::set<event const *>{&w};
+        while (not pending.empty()) {
+            auto const &x = *pending.back();
+            pending.pop_back();
+            if (releases(x)) {
+                return true;
+            }
+            if (not x.reads()) {
+                continue;
+            }
+            if (auto const it = writes_of.find(x.read);
+                it != std::end(writes_of)) {
+                for (auto const *y : it->second) {
+                    if (y->begin <= x.end and seen.insert(y).second) {
+                        pending.push_back(y);
+                    }
+                }
+            }
+        }
+        return false;
+    };
+
+    std::map<std::size_t, event const *> last_own_write{};
+    for (auto const &e : events) {
+        if (e.reads()) {
+            auto writers = std::vector<event const *>{};
+            if (auto const it = writes_of.find(e.read);
+                it != std::end(writes_of)) {
+                std::ranges::copy_if(it->second, std::back_inserter(writers),
+                                     [&](auto w) {
+                                         return w != &e and w->begin <= e.end;
+                                     });
+            }
+            auto const is_initial = initial ? *initial == e.read
+                                            : first_write == std::end(events) or
+                                                  e.begin <= first_write->end;
+
+            if (writers.empty() and not is_initial) {
+                violations.push_back({violation::kind::unwritten_value, e});
+            }
+
+            if (auto const it = last_own_write.find(e.thread);
+                it != std::end(last_own_write) and
+                it->second->written != e.read and
+                std::ranges::none_of(writers, [&](auto w) {
+                    return w->thread != e.thread;
+                })) {
+                violations.push_back({violation::kind::coherence, e});
+            }
+
+            if (options.missing_release and is_acquire(e.order) and
+                not writers.empty() and
+                std::ranges::none_of(writers, [&](auto w) {
+                    return w->thread == e.thread or in_release_sequence(*w);
+                })) {
+                violations.push_back({violation::kind::missing_release, e});
+            }
+        }
+        if (e.writes()) {
+            last_own_write[e.thread] = &e;
+        }
+    }
+
+    auto const weak_store = [](event const &e) {
+        return e.kind == op::store and e.order != std::memory_order_seq_cst;
+    };
+    if (events.size() <= options.linearizability_limit and
+        std::ranges::none_of(events, weak_store) and
+        not is_linearizable<location_spec>(events)) {
+        violations.push_back(
+            {violation::kind::not_linearizable, events.front()});
+    }
+}
+} // namespace detail
+
+// Check a recorded history location by location. Linearizability is only
+// checked for locations with no weaker-than-seq_cst stores (such a store may
+// become visible after its recorded interval ends), and with at most
+// options.linearizability_limit operations.
+[[nodiscard]] inline auto check(std::span<event const> history,
+                                check_options const &options = {})
+    -> std::vector<violation> {
+    std::map<void const *, std::vector<event>> locations{};
+    detail::release_fences_t release_fences{};
+    for (auto const &e : history) {
+        if (e.value_size != 0) {
+            locations[e.address].push_back(e);
+        } else if (e.kind == op::fence and detail::is_release(e.order)) {
+            release_fences.try_emplace(e.thread, e.end);
+        }
+    }
+
+    std::vector<violation> violations{};
+    for (auto const &[_, events] : locations) {
+        detail::check_location(events, release_fences, options, violations);
+    }
+    return violations;
+}
+} // namespace atomic
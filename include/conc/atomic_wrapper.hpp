@@ -0,0 +1,265 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace atomic {
+enum struct layout : std::uint8_t {
+    // aligned to alignment_of<T>
+    packed,
+    // aligned to (and occupying) at least a whole cache line, so that a
+    // contended value does not share its cache line with other data
+    padded
+};
+
+namespace detail {
+template <typename T, layout L>
+constexpr auto atomic_alignment =
+    L == layout::padded ? std::max(cache_line_size<>, alignment_of<T>)
+                        : alignment_of<T>;
+} // namespace detail
+
+// An object with the interface of std::atomic<T>, whose operations call the
+// free functions in atomic.hpp (and so the injected policy). The value is
+// stored as atomic_type_t<T>, aligned to alignment_of<T> (or padded to a cache
+// line), so platform configuration is applied automatically.
+template <typename T, layout L = layout::packed>
+class alignas(detail::atomic_alignment<T, L>) atomic {
+  public:
+    using value_type = T;
+    using storage_type = atomic_type_t<T>;
+
+  private:
+    storage_type value{};
+
+    constexpr static auto to_storage(T t) -> storage_type {
+        return static_cast<storage_type>(t);
+    }
+    constexpr static auto from_storage(storage_type s) -> T {
+        return static_cast<T>(s);
+    }
+
+    // Arithmetic is provided only when T is its own storage type: in a wider
+    // storage type, the results would not wrap as T does.
+    constexpr static bool integral =
+        std::integral<T> and not std::same_as<T, bool> and
+        std::same_as<T, storage_type>;
+
+    // Likewise, pointer arithmetic is provided only for a pointer to an object
+    // type that is stored as itself.
+    constexpr static bool object_pointer =
+        std::is_pointer_v<T> and
+        std::is_object_v<std::remove_pointer_t<T>> and
+        std::same_as<T, storage_type>;
+
+  public:
+    constexpr static bool is_always_lock_free =
+        ::atomic::is_always_lock_free<storage_type>;
+
+    constexpr atomic() = default;
+    constexpr explicit(false) atomic(T t) : value{to_storage(t)} {}
+
+    atomic(atomic const &) = delete;
+    auto operator=(atomic const &) -> atomic & = delete;
+
+    [[nodiscard]] auto
+    load(std::memory_order mo = std::memory_order_seq_cst) const -> T {
+        return from_storage(::atomic::load(value, mo));
+    }
+    auto store(T t, std::memory_order mo = std::memory_order_seq_cst)
+        -> void {
+        ::atomic::store(value, to_storage(t), mo);
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator T() const { return load(); }
+    auto operator=(T t) -> T {
+        store(t);
+        return t;
+    }
+
+    [[nodiscard]] auto
+    exchange(T t, std::memory_order mo = std::memory_order_seq_cst) -> T {
+        return from_storage(::atomic::exchange(value, to_storage(t), mo));
+    }
+
+    auto compare_exchange_strong(T &expected, T desired,
+                                 std::memory_order success,
+                                 std::memory_order failure) -> bool {
+        auto e = to_storage(expected);
+        auto const r = ::atomic::compare_exchange_strong(
+            value, e, to_storage(desired), success, failure);
+        expected = from_storage(e);
+        return r;
+    }
+    auto compare_exchange_strong(
+        T &expected, T desired,
+        std::memory_order mo = std::memory_order_seq_cst) -> bool {
+        return compare_exchange_strong(expected, desired, mo,
+                                       detail::failure_order(mo));
+    }
+
+    auto compare_exchange_weak(T &expected, T desired,
+                               std::memory_order success,
+                               std::memory_order failure) -> bool {
+        auto e = to_storage(expected);
+        auto const r = ::atomic::compare_exchange_weak(
+            value, e, to_storage(desired), success, failure);
+        expected = from_storage(e);
+        return r;
+    }
+    auto compare_exchange_weak(
+        T &expected, T desired,
+        std::memory_order mo = std::memory_order_seq_cst) -> bool {
+        return compare_exchange_weak(expected, desired, mo,
+                                     detail::failure_order(mo));
+    }
+
+    auto fetch_add(T t, std::memory_order mo = std::memory_order_seq_cst) -> T
+        requires integral
+    {
+        return from_storage(::atomic::fetch_add(value, to_storage(t), mo));
+    }
+    auto fetch_sub(T t, std::memory_order mo = std::memory_order_seq_cst) -> T
+        requires integral
+    {
+        return from_storage(::atomic::fetch_sub(value, to_storage(t), mo));
+    }
+    auto fetch_and(T t, std::memory_order mo = std::memory_order_seq_cst) -> T
+        requires integral
+    {
+        return from_storage(::atomic::fetch_and(value, to_storage(t), mo));
+    }
+    auto fetch_or(T t, std::memory_order mo = std::memory_order_seq_cst) -> T
+        requires integral
+    {
+        return from_storage(::atomic::fetch_or(value, to_storage(t), mo));
+    }
+    auto fetch_xor(T t, std::memory_order mo = std::memory_order_seq_cst) -> T
+        requires integral
+    {
+        return from_storage(::atomic::fetch_xor(value, to_storage(t), mo));
+    }
+
+    // Pointer arithmetic is scaled by the size of the pointee, as for
+    // std::atomic<T *>. A policy's fetch_add adds a value of the stored type,
+    // so this is a compare-exchange loop.
+    auto fetch_add(std::ptrdiff_t d,
+                   std::memory_order mo = std::memory_order_seq_cst) -> T
+        requires object_pointer
+    {
+        auto p = load(std::memory_order_relaxed);
+        while (not compare_exchange_weak(p, p + d, mo,
+                                         std::memory_order_relaxed)) {
+        }
+        return p;
+    }
+    auto fetch_sub(std::ptrdiff_t d,
+                   std::memory_order mo = std::memory_order_seq_cst) -> T
+        requires object_pointer
+    {
+        auto p = load(std::memory_order_relaxed);
+        while (not compare_exchange_weak(p, p - d, mo,
+                                         std::memory_order_relaxed)) {
+        }
+        return p;
+    }
+
+  private:
+    // Like std::atomic, arithmetic on a signed type wraps: compute it in the
+    // unsigned type, where overflow is defined
+    template <typename Op> static auto wrap(T a, T b, Op op) -> T {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<T>(op(static_cast<U>(a), static_cast<U>(b)));
+    }
+    constexpr static auto plus = [](auto x, auto y) { return x + y; };
+    constexpr static auto minus = [](auto x, auto y) { return x - y; };
+
+  public:
+    auto operator++() -> T
+        requires integral
+    {
+        return wrap(fetch_add(1), T{1}, plus);
+    }
+    auto operator++(int) -> T
+        requires integral
+    {
+        return fetch_add(1);
+    }
+    auto operator--() -> T
+        requires integral
+    {
+        return wrap(fetch_sub(1), T{1}, minus);
+    }
+    auto operator--(int) -> T
+        requires integral
+    {
+        return fetch_sub(1);
+    }
+    auto operator+=(T t) -> T
+        requires integral
+    {
+        return wrap(fetch_add(t), t, plus);
+    }
+    auto operator-=(T t) -> T
+        requires integral
+    {
+        return wrap(fetch_sub(t), t, minus);
+    }
+
+    auto operator++() -> T
+        requires object_pointer
+    {
+        return fetch_add(1) + 1;
+    }
+    auto operator++(int) -> T
+        requires object_pointer
+    {
+        return fetch_add(1);
+    }
+    auto operator--() -> T
+        requires object_pointer
+    {
+        return fetch_sub(1) - 1;
+    }
+    auto operator--(int) -> T
+        requires object_pointer
+    {
+        return fetch_sub(1);
+    }
+    auto operator+=(std::ptrdiff_t d) -> T
+        requires object_pointer
+    {
+        return fetch_add(d) + d;
+    }
+    auto operator-=(std::ptrdiff_t d) -> T
+        requires object_pointer
+    {
+        return fetch_sub(d) - d;
+    }
+
+    auto operator&=(T t) -> T
+        requires integral
+    {
+        return static_cast<T>(fetch_and(t) & t);
+    }
+    auto operator|=(T t) -> T
+        requires integral
+    {
+        return static_cast<T>(fetch_or(t) | t);
+    }
+    auto operator^=(T t) -> T
+        requires integral
+    {
+        return static_cast<T>(fetch_xor(t) ^ t);
+    }
+};
+
+template <typename T> using padded_atomic = atomic<T, layout::padded>;
+} // namespace atomic
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+#include <conc/concepts.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace conc {
+// Waits by spinning on the word, with a processor hint where there is one.
+// Needs no operating system, so it is the default.
+struct spin_wait {
+    static auto wait(std::uint32_t const &w, std::uint32_t old) -> void {
+        while (atomic::load(w, std::memory_order_acquire) == old) {
+#if defined(__x86_64__) or defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+    }
+    static auto notify_all(std::uint32_t &) -> void {}
+};
+
+// A single-use countdown: threads wait until the count reaches zero.
+// Wait is a wait_strategy, e.g. spin_wait, parking_wait (parking_lot.hpp), or
+// one provided by the platform.
+template <wait_strategy Wait = spin_wait> class latch {
+    std::uint32_t count;
+
+  public:
+    constexpr explicit latch(std::uint32_t expected) : count{expected} {}
+
+    latch(latch const &) = delete;
+    latch(latch &&) = delete;
+    auto operator=(latch const &) -> latch & = delete;
+    auto operator=(latch &&) -> latch & = delete;
+    ~latch() = default;
+
+    auto count_down(std::uint32_t n = 1) -> void {
+        if (atomic::fetch_sub(count, n, std::memory_order_acq_rel) == n) {
+            Wait::notify_all(count);
+        }
+    }
+
+    [[nodiscard]] auto try_wait() const -> bool {
+        return atomic::load(count, std::memory_order_acquire) == 0;
+    }
+
+    auto wait() const -> void {
+        for (auto c = atomic::load(count, std::memory_order_acquire); c != 0;
+             c = atomic::load(count, std::memory_order_acquire)) {
+            Wait::wait(count, c);
+        }
+    }
+
+    auto arrive_and_wait(std::uint32_t n = 1) -> void {
+        count_down(n);
+        wait();
+    }
+};
+
+// A reusable barrier for a fixed number of threads. Each thread records the
+// phase before arriving; the last to arrive resets the count and advances the
+// phase, releasing the others (a generalization of sense reversal).
+template <wait_strategy Wait = spin_wait> class barrier {
+    std::uint32_t expected;
+    alignas(atomic::cache_line_size<>) std::uint32_t remaining;
+    alignas(atomic::cache_line_size<>) std::uint32_t phase{};
+
+  public:
+    constexpr explicit barrier(std::uint32_t threads)
+        : expected{threads}, remaining{threads} {}
+
+    barrier(barrier const &) = delete;
+    barrier(barrier &&) = delete;
+    auto operator=(barrier const &) -> barrier & = delete;
+    auto operator=(barrier &&) -> barrier & = delete;
+    ~barrier() = default;
+
+    auto arrive_and_wait() -> void {
+        auto const p = atomic::load(phase, std::memory_order_acquire);
+        if (atomic::fetch_sub(remaining, 1u, std::memory_order_acq_rel) == 1) {
+            atomic::store(remaining, expected, std::memory_order_relaxed);
+            atomic::store(phase, p + 1, std::memory_order_release);
+            Wait::notify_all(phase);
+            return;
+        }
+        while (atomic::load(phase, std::memory_order_acquire) == p) {
+            Wait::wait(phase, p);
+        }
+    }
+};
+
+// A reusable combining-tree barrier for N threads, each of which identifies
+// itself by an index in [0, N). Threads arrive at leaf nodes shared by Fanin
+// threads; the last to arrive at a node arrives at its parent, and so on to the
+// root. So no counter is contended by more than Fanin threads, and the phase
+// word is written once per phase.
+template <std::size_t N, wait_strategy Wait = spin_wait,
+          std::size_t Fanin = 4>
+class tree_barrier {
+    static_assert(N > 0 and Fanin > 1);
+
+    constexpr static auto no_parent = std::numeric_limits<std::size_t>::max();
+
+    constexpr static auto node_count = [] {
+        auto total = std::size_t{};
+        auto n = N;
+        do {
+            n = (n + Fanin - 1) / Fanin;
+            total += n;
+        } while (n > 1);
+        return total;
+    }();
+
+    struct alignas(atomic::cache_line_size<>) node {
+        std::uint32_t remaining{};
+        std::uint32_t expected{};
+        std::size_t parent{no_parent};
+    };
+
+    std::array<node, node_count> nodes{};
+    alignas(atomic::cache_line_size<>) std::uint32_t phase{};
+
+  public:
+    constexpr tree_barrier() {
+        auto level_start = std::size_t{};
+        auto arrivals = N;
+        do {
+            auto const level_size = (arrivals + Fanin - 1) / Fanin;
+            for (auto j = std::size_t{}; j < level_size; ++j) {
+                auto &nd = nodes[level_start + j];
+                auto const rest = arrivals - j * Fanin;
+                nd.expected =
+                    static_cast<std::uint32_t>(rest < Fanin ? rest : Fanin);
+                nd.remaining = nd.expected;
+                if (level_size > 1) {
+                    nd.parent = level_start + level_size + j / Fanin;
+                }
+            }
+            level_start += level_size;
+            arrivals = level_size;
+        } while (arrivals > 1);
+    }
+
+    tree_barrier(tree_barrier const &) = delete;
+    tree_barrier(tree_barrier &&) = delete;
+    auto operator=(tree_barrier const &) -> tree_barrier & = delete;
+    auto operator=(tree_barrier &&) -> tree_barrier & = delete;
+    ~tree_barrier() = default;
+
+    auto arrive_and_wait(std::size_t participant) -> void {
+        auto const p = atomic::load(phase, std::memory_order_acquire);
+        for (auto i = participant / Fanin;;) {
+            auto &nd = nodes[i];
+            if (atomic::fetch_sub(nd.remaining, 1u,
+                                  std::memory_order_acq_rel) != 1) {
+                break;
+            }
+            // nobody arrives here again until the phase advances
+            atomic::store(nd.remaining, nd.expected, std::memory_order_relaxed);
+            if (nd.parent == no_parent) {
+                atomic::store(phase, p + 1, std::memory_order_release);
+                Wait::notify_all(phase);
+                return;
+            }
+            i = nd.parent;
+        }
+        while (atomic::load(phase, std::memory_order_acquire) == p) {
+            Wait::wait(phase, p);
+        }
+    }
+};
+} // namespace conc
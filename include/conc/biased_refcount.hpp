@@ -0,0 +1,248 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+#include <conc/refcount.hpp>
+
+#if __STDC_HOSTED__ == 0
+#error conc::biased_refcount requires a hosted implementation
+#endif
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+namespace conc {
+template <typename T> class biased_refcount;
+
+namespace detail {
+class biased_owner;
+
+// The state of a biased reference count. The owning thread counts its
+// references in local, without atomic operations. Other threads count theirs
+// in shared, which holds a signed count (shifted left by 2) and two flags:
+//
+//  - merged: local has been folded into shared, and the object has no owner;
+//    from then on every thread uses shared, and the count is exact
+//  - queued: another thread drove the count in shared negative (it dropped a
+//    reference counted in local), so the object has been queued for its owner
+//    to merge; meanwhile, only the owner (or its exit) may destroy it
+class biased_node {
+    friend class biased_owner;
+    template <typename> friend class conc::biased_refcount;
+
+    constexpr static auto merged = std::uint32_t{0b01u};
+    constexpr static auto queued = std::uint32_t{0b10u};
+    constexpr static auto one = std::uint32_t{0b100u};
+
+    static constexpr auto count(std::uint32_t s) -> std::int32_t {
+        return std::bit_cast<std::int32_t>(s) >> 2;
+    }
+
+    // true if the count in s means that the object must now be destroyed
+    static constexpr auto is_dead(std::uint32_t s) -> bool {
+        return (s & (merged | queued)) == merged and count(s) == 0;
+    }
+
+    using destroy_fn = auto (*)(biased_node *) -> void;
+
+    biased_owner *owner;
+    std::uint32_t local{1};
+    std::uint32_t shared{};
+    biased_node *next{};
+    destroy_fn destroy;
+
+    explicit biased_node(destroy_fn d);
+
+    // fold local into shared; only called by the owner, or after it exits
+    auto merge(bool was_queued) -> bool;
+
+    // called for an object taken from the queue of its owner o
+    auto settle(biased_owner &o) -> bool;
+
+  public:
+    biased_node(biased_node const &) = delete;
+    biased_node(biased_node &&) = delete;
+    auto operator=(biased_node const &) -> biased_node & = delete;
+    auto operator=(biased_node &&) -> biased_node & = delete;
+    ~biased_node() = default;
+};
+
+// Each thread that creates biased objects has an owner record, which holds
+// the queue of its objects released by other threads. The record lives until
+// the thread has exited and none of its objects is still unmerged.
+class biased_owner {
+    friend class biased_node;
+
+    // marks a queue that will never be drained again
+    static auto closed() -> biased_node * {
+        return std::bit_cast<biased_node *>(std::uintptr_t{1});
+    }
+
+    biased_node *queue{};
+    // the thread, plus each of its unmerged objects
+    std::uint32_t refs{1};
+
+    auto add_ref() -> void {
+        atomic::fetch_add(refs, 1u, std::memory_order_relaxed);
+    }
+    auto release() -> void {
+        if (atomic::fetch_sub(refs, 1u, std::memory_order_release) == 1) {
+            atomic::thread_fence(std::memory_order_acquire);
+            delete this;
+        }
+    }
+
+    auto settle_all(biased_node *n) -> void {
+        while (n != nullptr) {
+            auto *const next = n->next;
+            if (n->settle(*this)) {
+                n->destroy(n);
+            }
+            n = next;
+        }
+    }
+
+    struct handle {
+        biased_owner *owner{new biased_owner};
+
+        handle() = default;
+        handle(handle const &) = delete;
+        handle(handle &&) = delete;
+        auto operator=(handle const &) -> handle & = delete;
+        auto operator=(handle &&) -> handle & = delete;
+        ~handle() {
+            owner->settle_all(atomic::exchange(owner->queue, closed(),
+                                               std::memory_order_acq_rel));
+            owner->release();
+        }
+    };
+
+  public:
+    [[nodiscard]] static auto current() -> biased_owner * {
+        thread_local handle h{};
+        return h.owner;
+    }
+
+    [[nodiscard]] auto has_queued() const -> bool {
+        return atomic::load(queue, std::memory_order_relaxed) != nullptr;
+    }
+
+    // merge (and possibly destroy) the objects queued by other threads
+    auto collect() -> void {
+        settle_all(
+            atomic::exchange(queue, nullptr, std::memory_order_acquire));
+    }
+
+    // called by a thread other than the owner; true if n must be destroyed
+    auto push(biased_node &n) -> bool {
+        auto *head = atomic::load(queue, std::memory_order_acquire);
+        do {
+            if (head == closed()) {
+                // the owner has exited: nobody else will touch local
+                return n.settle(*this);
+            }
+            n.next = head;
+        } while (not atomic::compare_exchange_weak(queue, head, &n,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire));
+        return false;
+    }
+};
+
+inline biased_node::biased_node(destroy_fn d)
+    : owner{biased_owner::current()}, destroy{d} {
+    owner->add_ref();
+}
+
+inline auto biased_node::merge(bool was_queued) -> bool {
+    auto *const o = atomic::load(owner, std::memory_order_relaxed);
+    auto const delta =
+        local * one + merged - (was_queued ? queued : std::uint32_t{});
+    local = 0;
+    auto const s =
+        atomic::fetch_add(shared, delta, std::memory_order_acq_rel) + delta;
+    // a thread that sees no owner also sees the object merged
+    atomic::store(owner, nullptr, std::memory_order_release);
+    // a queued object keeps its owner's record alive until it is settled
+    if ((s & queued) == 0) {
+        o->release();
+    }
+    return is_dead(s);
+}
+
+inline auto biased_node::settle(biased_owner &o) -> bool {
+    if ((atomic::load(shared, std::memory_order_relaxed) & merged) != 0) {
+        auto const s =
+            atomic::fetch_sub(shared, queued, std::memory_order_acq_rel) -
+            queued;
+        o.release();
+        return is_dead(s);
+    }
+    return merge(true);
+}
+} // namespace detail
+
+// A biased reference count, to be used as a base class of T, which is
+// destroyed with delete. References taken and dropped by the thread that
+// created the object are counted without any atomic read-modify-write; other
+// threads use an atomic count. When another thread drops a reference that was
+// counted by the owner, the object is queued for the owner to reconcile the
+// counts, which it does the next time it drops a reference to any biased
+// object, calls collect_biased_refcounts(), or exits.
+template <typename T> class biased_refcount : detail::biased_node {
+    static auto destroy_object(detail::biased_node *n) -> void {
+        delete static_cast<T *>(static_cast<biased_refcount *>(n));
+    }
+
+  public:
+    biased_refcount() : biased_node{destroy_object} {}
+
+    auto add_ref() -> void {
+        if (atomic::load(owner, std::memory_order_relaxed) ==
+            detail::biased_owner::current()) {
+            ++local;
+        } else {
+            atomic::fetch_add(shared, one, std::memory_order_relaxed);
+        }
+    }
+
+    // true if this dropped the last reference: the caller must then destroy
+    // the object
+    [[nodiscard]] auto release() -> bool {
+        auto *const me = detail::biased_owner::current();
+        if (atomic::load(owner, std::memory_order_relaxed) == me) {
+            if (me->has_queued()) [[unlikely]] {
+                me->collect();
+            }
+            // collect() may have merged this object
+            if (atomic::load(owner, std::memory_order_relaxed) == me) {
+                return --local == 0 and merge(false);
+            }
+        }
+
+        // if the object is not merged, its owner's record stays alive at least
+        // until this object is queued and settled
+        auto *const o = atomic::load(owner, std::memory_order_acquire);
+        auto s = atomic::load(shared, std::memory_order_relaxed);
+        auto desired = std::uint32_t{};
+        do {
+            desired = s - one;
+            if ((desired & (merged | queued)) == 0 and count(desired) < 0) {
+                desired |= queued;
+            }
+        } while (not atomic::compare_exchange_weak(shared, s, desired,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed));
+        if ((desired & queued) != 0 and (s & queued) == 0) {
+            return o->push(*this);
+        }
+        return is_dead(desired);
+    }
+};
+
+// merge the calling thread's biased objects whose references were dropped by
+// other threads
+inline auto collect_biased_refcounts() -> void {
+    detail::biased_owner::current()->collect();
+}
+} // namespace conc
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <concepts>
+#include <cstdint>
 
 namespace conc {
 template <typename T>
@@ -9,6 +10,21 @@ concept policy = requires(auto (*f)()->int &&, auto (*pred)()->bool) {
     { T::call_in_critical_section(f) } -> std::same_as<int &&>;
     { T::call_in_critical_section(f, pred) } -> std::same_as<int &&>;
 };
+
+template <typename T>
+concept read_section_policy =
+    policy<T> and requires(auto (*f)()->int &&) {
+        { T::call_in_read_section(f) } -> std::same_as<int &&>;
+    };
+
+// how a thread waits for a 32-bit word to change from a value it has seen;
+// a waiter only reads the word
+template <typename T>
+concept wait_strategy = requires(std::uint32_t const &cw, std::uint32_t &w,
+                                 std::uint32_t old) {
+    { T::wait(cw, old) } -> std::same_as<void>;
+    { T::notify_all(w) } -> std::same_as<void>;
+};
 } // namespace conc
 
 namespace atomic {
@@ -49,4 +65,24 @@ concept bitwise_policy =
 
 template <typename T>
 concept policy = exchange_policy<T> and add_sub_policy<T> and bitwise_policy<T>;
+
+template <typename T>
+concept compare_exchange_policy =
+    load_store_policy<T> and
+    requires(int &a, int &expected, int value, std::memory_order mo) {
+        { T::compare_exchange_strong(a, expected, value) } -> std::same_as<bool>;
+        {
+            T::compare_exchange_strong(a, expected, value, mo, mo)
+        } -> std::same_as<bool>;
+        { T::compare_exchange_weak(a, expected, value) } -> std::same_as<bool>;
+        {
+            T::compare_exchange_weak(a, expected, value, mo, mo)
+        } -> std::same_as<bool>;
+    };
+
+template <typename T>
+concept fence_policy = requires(std::memory_order mo) {
+    { T::thread_fence() } -> std::same_as<void>;
+    { T::thread_fence(mo) } -> std::same_as<void>;
+};
 } // namespace atomic
@@ -14,6 +14,7 @@
 #endif
 
 #include <concepts>
+#include <type_traits>
 #include <utility>
 
 namespace conc {
@@ -53,6 +54,9 @@ template <typename = void> struct standard_policy {
 #endif
 } // namespace detail
 
+// The policy used unless another is injected, e.g. as the Base of a decorator
+template <typename... Ts> using standard_policy = detail::standard_policy<Ts...>;
+
 template <typename...> inline auto injected_policy = detail::standard_policy{};
 
 template <typename Uniq = decltype([] {}), typename... DummyArgs,
@@ -65,6 +69,21 @@ call_in_critical_section(F &&f, Pred &&...pred)
     return p.template call_in_critical_section<Uniq>(
         std::forward<F>(f), std::forward<Pred>(pred)...);
 }
+
+// A critical section that only reads the data protected by Uniq. If the
+// policy does not distinguish readers, this is an ordinary critical section.
+template <typename Uniq = decltype([] {}), typename... DummyArgs,
+          std::invocable F>
+    requires(sizeof...(DummyArgs) == 0)
+__attribute__((always_inline, flatten)) inline auto
+call_in_read_section(F &&f) -> decltype(std::forward<F>(f)()) {
+    policy auto &p = injected_policy<DummyArgs...>;
+    if constexpr (read_section_policy<std::remove_cvref_t<decltype(p)>>) {
+        return p.template call_in_read_section<Uniq>(std::forward<F>(f));
+    } else {
+        return p.template call_in_critical_section<Uniq>(std::forward<F>(f));
+    }
+}
 } // namespace conc
 
 #undef CONC_HAS_MUTEX
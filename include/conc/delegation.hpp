@@ -0,0 +1,308 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+#include <conc/eventcount.hpp>
+#include <conc/parking_lot.hpp>
+
+#if __STDC_HOSTED__ == 0
+#error conc::delegation_policy requires a hosted implementation
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace conc {
+namespace detail {
+// The result of a delegated call: written by the server thread, then taken by
+// the client once the call is complete.
+template <typename R> class delegated_result {
+    std::optional<R> value{};
+
+  public:
+    template <typename F> auto set(F &&f) -> void {
+        value.emplace(std::forward<F>(f)());
+    }
+    auto take() -> R { return std::move(*value); }
+};
+
+template <typename R>
+    requires std::is_reference_v<R>
+class delegated_result<R> {
+    std::remove_reference_t<R> *value{};
+
+  public:
+    template <typename F> auto set(F &&f) -> void {
+        value = std::addressof(std::forward<F>(f)());
+    }
+    auto take() -> R { return static_cast<R>(*value); }
+};
+
+template <> class delegated_result<void> {
+  public:
+    template <typename F> auto set(F &&f) -> void { std::forward<F>(f)(); }
+    auto take() -> void {}
+};
+
+// The tag conc::call_in_critical_section gives a call site that names none: a
+// captureless lambda type, unique to the call site.
+template <typename Tag>
+concept call_site_tag = requires {
+    { +Tag{} } -> std::same_as<void (*)()>;
+};
+} // namespace detail
+
+// A critical section policy that runs every critical section for a tag on a
+// dedicated server thread for that tag. A client thread writes its request (a
+// pointer to the closure) to its own cache-line-sized mailbox and waits for
+// the server to run it; so the data protected by the tag stays in the server's
+// cache, and the only cache lines that move between cores are the mailboxes.
+//
+// Each tag supports up to MaxClients threads with mailboxes of their own;
+// further threads share a small pool of mailboxes, claiming one for each call.
+// A critical section entered from within a critical section with the same tag
+// (i.e. on the server) runs inline; its predicate must already be true.
+//
+// Each tag has its own server thread, so a call site must name its tag: an
+// untagged call site would get a tag (and so a thread) of its own.
+template <std::size_t MaxClients = 64> class delegation_policy {
+    enum : std::uint32_t { empty, pending, done };
+
+    // mailboxes never owned by a thread, claimed for one call at a time
+    constexpr static auto per_call_mailboxes = std::size_t{4};
+
+    struct alignas(atomic::cache_line_size<>) mailbox {
+        std::uint32_t state{empty};
+        std::uint32_t claimed{};
+        // returns false if the call's predicate is false
+        bool (*run)(void *){};
+        void *ctx{};
+    };
+
+    class server {
+        std::array<mailbox, MaxClients + per_call_mailboxes> mailboxes{};
+        alignas(atomic::cache_line_size<>) eventcount requests{};
+        std::jthread thread;
+
+        struct sweep_result {
+            // some request ran
+            bool progress{};
+            // some request is waiting for its predicate
+            bool waiting{};
+        };
+
+        // run each pending request whose predicate is true
+        auto sweep() -> sweep_result {
+            auto r = sweep_result{};
+            for (auto &mb : mailboxes) {
+                if (atomic::load(mb.state, std::memory_order_acquire) !=
+                    pending) {
+                    continue;
+                }
+                if (mb.run(mb.ctx)) {
+                    atomic::store(mb.state, done, std::memory_order_release);
+                    unpark_all(&mb.state);
+                    r.progress = true;
+                } else {
+                    r.waiting = true;
+                }
+            }
+            return r;
+        }
+
+        auto serve(std::stop_token const &st) -> void {
+            constexpr auto min_backoff = std::chrono::microseconds{1};
+            constexpr auto max_backoff = std::chrono::milliseconds{1};
+            auto backoff = std::chrono::microseconds{min_backoff};
+            while (not st.stop_requested()) {
+                // a request that ran may have made another's predicate true
+                auto const r = sweep();
+                if (r.progress) {
+                    backoff = min_backoff;
+                    continue;
+                }
+                // a predicate may also be made true outside any critical
+                // section, which wakes nobody, so poll while one is waiting
+                if (r.waiting) {
+                    std::this_thread::sleep_for(backoff);
+                    backoff = std::min<std::chrono::microseconds>(backoff * 2,
+                                                                  max_backoff);
+                    continue;
+                }
+                auto const key = requests.prepare_wait();
+                if (st.stop_requested() or sweep().progress) {
+                    requests.cancel_wait();
+                    continue;
+                }
+                requests.commit_wait(key);
+            }
+        }
+
+      public:
+        server() : thread{[this](std::stop_token st) { serve(st); }} {}
+
+        server(server const &) = delete;
+        server(server &&) = delete;
+        auto operator=(server const &) -> server & = delete;
+        auto operator=(server &&) -> server & = delete;
+        ~server() {
+            thread.request_stop();
+            requests.notify();
+        }
+
+        [[nodiscard]] auto on_server_thread() const -> bool {
+            return std::this_thread::get_id() == thread.get_id();
+        }
+
+        // claim a mailbox to keep, or nullptr if none is left
+        [[nodiscard]] auto try_claim() -> mailbox * {
+            return claim_from(std::span{mailboxes}.first(MaxClients));
+        }
+
+        // claim a mailbox for one call; it must be released after the call
+        [[nodiscard]] auto try_claim_per_call() -> mailbox * {
+            return claim_from(std::span{mailboxes}.last(per_call_mailboxes));
+        }
+
+      private:
+        [[nodiscard]] static auto claim_from(std::span<mailbox> mbs)
+            -> mailbox * {
+            for (auto &mb : mbs) {
+                auto expected = std::uint32_t{};
+                if (atomic::compare_exchange_strong(
+                        mb.claimed, expected, 1u, std::memory_order_acquire,
+                        std::memory_order_relaxed)) {
+                    return &mb;
+                }
+            }
+            return nullptr;
+        }
+
+      public:
+        static auto release(mailbox &mb) -> void {
+            atomic::store(mb.claimed, 0u, std::memory_order_release);
+        }
+
+        // run the request in mb on the server and wait for it to complete
+        auto call(mailbox &mb, bool (*run)(void *), void *ctx) -> void {
+            mb.run = run;
+            mb.ctx = ctx;
+            atomic::store(mb.state, pending, std::memory_order_release);
+            requests.notify();
+
+            constexpr auto spins = 1'000;
+            for (auto i = 0; i < spins; ++i) {
+                if (atomic::load(mb.state, std::memory_order_acquire) ==
+                    done) {
+                    break;
+                }
+            }
+            while (atomic::load(mb.state, std::memory_order_acquire) != done) {
+                park(&mb.state, [&] {
+                    return atomic::load(mb.state, std::memory_order_acquire) !=
+                           done;
+                });
+            }
+            atomic::store(mb.state, empty, std::memory_order_relaxed);
+        }
+    };
+
+    template <typename Tag> static auto server_for() -> server & {
+        static server s{};
+        return s;
+    }
+
+    struct mailbox_handle {
+        explicit mailbox_handle(server &s) : mb{s.try_claim()} {}
+        ~mailbox_handle() {
+            if (mb != nullptr) {
+                server::release(*mb);
+            }
+        }
+        mailbox_handle(mailbox_handle const &) = delete;
+        mailbox_handle(mailbox_handle &&) = delete;
+        auto operator=(mailbox_handle const &) -> mailbox_handle & = delete;
+        auto operator=(mailbox_handle &&) -> mailbox_handle & = delete;
+
+        mailbox *mb{};
+    };
+
+    template <typename Tag> static auto local_mailbox(server &s) -> mailbox * {
+        thread_local mailbox_handle h{s};
+        return h.mb;
+    }
+
+    template <typename F, typename... Pred> struct request {
+        using result_t = decltype(std::declval<F>()());
+
+        F &&f;
+        [[no_unique_address]] std::tuple<Pred &...> pred;
+        detail::delegated_result<result_t> result{};
+        std::exception_ptr exception{};
+
+        static auto run(void *ctx) -> bool {
+            auto &r = *static_cast<request *>(ctx);
+            try {
+                if (not std::apply([](auto &...p) { return (... and p()); },
+                                   r.pred)) {
+                    return false;
+                }
+                r.result.set(std::forward<F>(r.f));
+            } catch (...) {
+                r.exception = std::current_exception();
+            }
+            return true;
+        }
+    };
+
+  public:
+    template <typename Uniq = void, std::invocable F, std::predicate... Pred>
+        requires(sizeof...(Pred) < 2)
+    static auto call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(std::forward<F>(f)()) {
+        static_assert(not detail::call_site_tag<Uniq>,
+                      "conc::delegation_policy starts a server thread for each "
+                      "tag: name the tag of this critical section");
+        auto &s = server_for<Uniq>();
+        if (s.on_server_thread()) {
+            // nested: nothing else can run until the outer section finishes,
+            // so a false predicate would never become true
+            if (not(... and pred())) {
+                std::terminate();
+            }
+            return std::forward<F>(f)();
+        }
+
+        request<F, Pred...> r{std::forward<F>(f), {pred...}};
+        if (auto *mb = local_mailbox<Uniq>(s); mb != nullptr) [[likely]] {
+            s.call(*mb, request<F, Pred...>::run, &r);
+        } else {
+            auto *other = s.try_claim_per_call();
+            while (other == nullptr) {
+                std::this_thread::yield();
+                other = s.try_claim_per_call();
+            }
+            s.call(*other, request<F, Pred...>::run, &r);
+            server::release(*other);
+        }
+
+        if (r.exception) {
+            std::rethrow_exception(r.exception);
+        }
+        return r.result.take();
+    }
+};
+} // namespace conc
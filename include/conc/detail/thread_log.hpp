@@ -0,0 +1,156 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace conc::detail {
+// What a thread_log does when a thread's buffer is full
+enum struct log_mode { drop_newest, overwrite_oldest };
+
+// A per-thread, single-writer event log. Each thread appends to its own
+// buffer without synchronizing with other threads; a collector may read all
+// buffers concurrently and sees a consistent prefix of each.
+//
+// In overwrite_oldest mode each buffer is a ring that keeps the most recent
+// Capacity events. A collector reading concurrently with appends may then see
+// an event that is being overwritten, so collect while threads are quiescent.
+//
+// A thread's buffer is allocated when it first appends. When the thread exits,
+// its buffer is freed if it is empty, and otherwise kept for collection until
+// the next reset().
+//
+// The log's own atomic operations go directly to the standard atomic policy so
+// that it can be used to implement an injected atomic policy.
+template <typename Event, std::size_t Capacity, typename Tag,
+          log_mode Mode = log_mode::drop_newest>
+class thread_log {
+    static_assert(Mode != log_mode::overwrite_oldest or
+                      std::has_single_bit(Capacity),
+                  "A ring buffer thread_log must have a power-of-two capacity");
+
+    using sp = atomic::detail::standard_policy;
+
+    struct buffer {
+        std::array<Event, Capacity> events{};
+        // in overwrite_oldest mode, the total number of events appended
+        std::size_t size{};
+        std::size_t dropped{};
+        std::size_t thread_id{};
+        // the thread has exited: nothing more will be appended
+        bool exited{};
+    };
+
+    static inline std::mutex m{};
+    static inline std::vector<std::unique_ptr<buffer>> buffers{};
+    static inline std::size_t next_thread_id{};
+
+    // owns a thread's buffer until the thread exits
+    struct owner {
+        buffer *b{};
+
+        owner() {
+            std::lock_guard l{m};
+            auto &p = buffers.emplace_back(std::make_unique<buffer>());
+            p->thread_id = next_thread_id++;
+            b = p.get();
+        }
+        owner(owner const &) = delete;
+        owner(owner &&) = delete;
+        auto operator=(owner const &) -> owner & = delete;
+        auto operator=(owner &&) -> owner & = delete;
+
+        ~owner() {
+            std::lock_guard l{m};
+            if (b->size == 0 and b->dropped == 0) {
+                std::erase_if(buffers,
+                              [&](auto const &p) { return p.get() == b; });
+            } else {
+                b->exited = true;
+            }
+        }
+    };
+
+    static auto local() -> buffer & {
+        thread_local owner o{};
+        return *o.b;
+    }
+
+  public:
+    constexpr static auto capacity = Capacity;
+
+    [[nodiscard]] static auto thread_id() -> std::size_t {
+        return local().thread_id;
+    }
+
+    static auto append(Event const &e) -> void {
+        append_with([&]() -> Event const & { return e; });
+    }
+
+    // append make(), called once this thread's buffer exists, so that e.g. a
+    // timestamp taken by make() does not include allocating the buffer
+    template <typename F> static auto append_with(F &&make) -> void {
+        auto &b = local();
+        auto n = b.size;
+        if constexpr (Mode == log_mode::overwrite_oldest) {
+            b.events[n & (Capacity - 1)] = std::forward<F>(make)();
+            ++n;
+            sp::store(b.size, n, std::memory_order_release);
+            return;
+        }
+        if (n == Capacity) {
+            auto d = b.dropped + 1;
+            sp::store(b.dropped, d, std::memory_order_relaxed);
+            return;
+        }
+        b.events[n] = std::forward<F>(make)();
+        ++n;
+        sp::store(b.size, n, std::memory_order_release);
+    }
+
+    // call f(thread_id, event) for each logged event, in per-thread order
+    template <typename F> static auto for_each(F &&f) -> void {
+        std::lock_guard l{m};
+        for (auto const &b : buffers) {
+            auto const n = sp::load(b->size, std::memory_order_acquire);
+            auto const first = n > Capacity ? n - Capacity : std::size_t{};
+            for (auto i = first; i < n; ++i) {
+                f(b->thread_id, b->events[i % Capacity]);
+            }
+        }
+    }
+
+    // events dropped when a buffer was full, or overwritten in a ring
+    [[nodiscard]] static auto dropped() -> std::size_t {
+        std::lock_guard l{m};
+        auto total = std::size_t{};
+        for (auto const &b : buffers) {
+            if constexpr (Mode == log_mode::overwrite_oldest) {
+                auto const n = sp::load(b->size, std::memory_order_relaxed);
+                total += n > Capacity ? n - Capacity : std::size_t{};
+            } else {
+                total += sp::load(b->dropped, std::memory_order_relaxed);
+            }
+        }
+        return total;
+    }
+
+    // discard all events, freeing the buffers of exited threads; only call
+    // while no thread is appending
+    static auto reset() -> void {
+        std::lock_guard l{m};
+        std::erase_if(buffers, [](auto const &b) { return b->exited; });
+        for (auto const &b : buffers) {
+            auto zero = std::size_t{};
+            sp::store(b->size, zero, std::memory_order_relaxed);
+            sp::store(b->dropped, zero, std::memory_order_relaxed);
+        }
+    }
+};
+} // namespace conc::detail
@@ -0,0 +1,52 @@
+#pragma once
+
+#if defined(__x86_64__) or defined(__i386__)
+#include <x86intrin.h>
+#define CONC_HAS_RDTSC 1
+#else
+#define CONC_HAS_RDTSC 0
+#endif
+
+#include <chrono>
+#include <cstdint>
+
+namespace conc::detail {
+[[nodiscard]] inline auto steady_ns() -> std::uint64_t {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+// A cheap monotonic timestamp: the time-stamp counter where there is one
+// (assumed to be invariant, as on any recent x86), otherwise nanoseconds.
+[[nodiscard]] inline auto timestamp() -> std::uint64_t {
+#if CONC_HAS_RDTSC
+    return __rdtsc();
+#else
+    return steady_ns();
+#endif
+}
+
+// The number of timestamp ticks per microsecond, calibrated on first use
+[[nodiscard]] inline auto timestamp_ticks_per_us() -> double {
+#if CONC_HAS_RDTSC
+    static auto const ticks = [] {
+        auto const ns0 = steady_ns();
+        auto const t0 = timestamp();
+        auto ns1 = ns0;
+        while (ns1 - ns0 < 10'000'000u) {
+            ns1 = steady_ns();
+        }
+        auto const t1 = timestamp();
+        return static_cast<double>(t1 - t0) * 1'000.0 /
+               static_cast<double>(ns1 - ns0);
+    }();
+    return ticks;
+#else
+    return 1'000.0;
+#endif
+}
+} // namespace conc::detail
+
+#undef CONC_HAS_RDTSC
@@ -0,0 +1,438 @@
+#pragma once
+
+#include <conc/concurrency.hpp>
+
+#if __STDC_HOSTED__ == 0
+#error conc::deterministic_test_policy is designed for desktop testing and requires a hosted implementation
+#endif
+
+#include <algorithm>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace conc {
+enum struct schedule_strategy : std::uint8_t { random, pct, exhaustive, replay };
+
+struct schedule_options {
+    schedule_strategy strategy{schedule_strategy::random};
+    std::uint64_t seed{};
+    std::size_t iterations{1'000};
+    std::size_t max_steps{10'000};
+    // PCT: number of priority change points + 1, and the expected run length
+    std::size_t pct_depth{3};
+    std::size_t pct_steps{100};
+    // replay: the thread chosen at each scheduling point
+    std::vector<std::size_t> schedule{};
+};
+
+struct schedule_result {
+    bool failed{};
+    bool exhausted{};
+    std::size_t iterations{};
+    std::uint64_t seed{};
+    char const *reason{};
+    std::vector<std::size_t> schedule{};
+};
+
+class deterministic_test_policy;
+
+class test_scheduler {
+    friend class deterministic_test_policy;
+
+    static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    struct abort_run {};
+
+    struct thread_state {
+        std::thread thread{};
+        void const *waiting_on{};
+        std::uint64_t priority{};
+        // found its predicate false, and nothing has run since that could
+        // have made it true
+        bool retrying{};
+        bool done{};
+    };
+
+    struct choice {
+        std::size_t index{};
+        std::size_t count{};
+    };
+
+    schedule_options const &opts;
+    std::mt19937_64 rng;
+    std::vector<choice> prefix;
+    std::vector<choice> choices{};
+    std::vector<std::size_t> trace{};
+    std::vector<std::size_t> change_points{};
+
+    std::mutex m{};
+    std::condition_variable cv{};
+    std::vector<thread_state> threads{};
+    std::vector<void const *> held{};
+    std::size_t active{none};
+    std::size_t finished{};
+    std::size_t steps{};
+    char const *reason{};
+    bool aborted{};
+    bool joined{};
+
+    static auto current_ref() -> test_scheduler *& {
+        thread_local test_scheduler *s{};
+        return s;
+    }
+
+    static auto this_thread() -> std::size_t & {
+        thread_local std::size_t id{none};
+        return id;
+    }
+
+    test_scheduler(schedule_options const &o, std::uint64_t seed,
+                   std::vector<choice> p)
+        : opts{o}, rng{seed}, prefix{std::move(p)} {
+        if (opts.strategy == schedule_strategy::pct) {
+            for (auto i = std::size_t{1}; i < opts.pct_depth; ++i) {
+                change_points.push_back(1 + rng() % opts.pct_steps);
+            }
+        }
+    }
+
+    auto fail(char const *why) -> void {
+        if (reason == nullptr) {
+            reason = why;
+        }
+    }
+
+    auto abort(char const *why) -> void {
+        fail(why);
+        aborted = true;
+        active = none;
+    }
+
+    [[nodiscard]] auto is_runnable(thread_state const &t) const -> bool {
+        return not t.done and
+               (t.waiting_on == nullptr or
+                std::ranges::find(held, t.waiting_on) == std::end(held));
+    }
+
+    auto choose(std::vector<std::size_t> const &runnable) -> std::size_t {
+        switch (opts.strategy) {
+        case schedule_strategy::random:
+            return runnable[rng() % runnable.size()];
+
+        case schedule_strategy::pct: {
+            for (auto i = std::size_t{}; i < change_points.size(); ++i) {
+                if (change_points[i] == steps and active != none) {
+                    threads[active].priority = i;
+                }
+            }
+            return *std::ranges::max_element(
+                runnable, std::less{},
+                [&](auto id) { return threads[id].priority; });
+        }
+
+        case schedule_strategy::exhaustive: {
+            if (runnable.size() == 1) {
+                return runnable[0];
+            }
+            auto const pos = choices.size();
+            auto const idx =
+                pos < prefix.size()
+                    ? std::min(prefix[pos].index, runnable.size() - 1)
+                    : std::size_t{};
+            choices.push_back({idx, runnable.size()});
+            return runnable[idx];
+        }
+
+        case schedule_strategy::replay: {
+            auto const pos = trace.size();
+            if (pos < opts.schedule.size() and
+                std::ranges::find(runnable, opts.schedule[pos]) !=
+                    std::end(runnable)) {
+                return opts.schedule[pos];
+            }
+            return runnable[0];
+        }
+        }
+        return runnable[0];
+    }
+
+    // called with m held: pick the thread that runs after this scheduling
+    // point
+    auto pick_next() -> void {
+        std::vector<std::size_t> runnable{};
+        for (auto i = std::size_t{}; i < threads.size(); ++i) {
+            if (is_runnable(threads[i]) and not threads[i].retrying) {
+                runnable.push_back(i);
+            }
+        }
+        // threads that are only retrying predicates cannot make progress
+        if (runnable.empty()) {
+            if (finished == threads.size()) {
+                active = none;
+            } else {
+                abort("deadlock");
+            }
+            return;
+        }
+        if (++steps > opts.max_steps) {
+            abort("step limit exceeded");
+            return;
+        }
+        active = choose(runnable);
+        trace.push_back(active);
+    }
+
+    auto switch_from(std::unique_lock<std::mutex> &l, std::size_t me) -> void {
+        pick_next();
+        cv.notify_all();
+        cv.wait(l, [&] { return active == me or aborted; });
+        if (aborted) {
+            throw abort_run{};
+        }
+    }
+
+    template <typename F> auto run_thread(std::size_t id, F &f) -> void {
+        current_ref() = this;
+        this_thread() = id;
+        try {
+            {
+                std::unique_lock l{m};
+                cv.wait(l, [&] { return active == id or aborted; });
+                if (aborted) {
+                    throw abort_run{};
+                }
+            }
+            f();
+        } catch (abort_run const &) {
+        } catch (...) {
+            std::lock_guard l{m};
+            fail("exception thrown");
+        }
+
+        std::lock_guard l{m};
+        threads[id].done = true;
+        ++finished;
+        made_progress(id);
+        if (not aborted) {
+            pick_next();
+        }
+        cv.notify_all();
+    }
+
+    // thread me has run code that may change what other threads' predicates
+    // see
+    auto made_progress(std::size_t me) -> void {
+        for (auto i = std::size_t{}; i < threads.size(); ++i) {
+            if (i != me) {
+                threads[i].retrying = false;
+            }
+        }
+    }
+
+    // retry: the thread is entering the critical section again because its
+    // predicate was false, so it runs again only after another thread does
+    auto lock(void const *key, bool retry) -> void {
+        std::unique_lock l{m};
+        auto const me = this_thread();
+        if (retry) {
+            threads[me].retrying = true;
+        } else {
+            made_progress(me);
+        }
+        threads[me].waiting_on = key;
+        switch_from(l, me);
+        threads[me].waiting_on = nullptr;
+        held.push_back(key);
+    }
+
+    auto unlock(void const *key) -> void {
+        std::lock_guard l{m};
+        if (auto it = std::ranges::find(held, key); it != std::end(held)) {
+            held.erase(it);
+        }
+    }
+
+    // the next exhaustive prefix: the last choice that has an untried
+    // alternative, advanced by one
+    [[nodiscard]] auto next_prefix() const -> std::vector<choice> {
+        auto p = choices;
+        while (not p.empty() and p.back().index + 1 >= p.back().count) {
+            p.pop_back();
+        }
+        if (not p.empty()) {
+            ++p.back().index;
+        }
+        return p;
+    }
+
+    static auto report(std::size_t iteration, std::uint64_t seed,
+                       schedule_result const &r) -> void {
+        std::fprintf(stderr,
+                     "conc::test_scheduler: %s in iteration %zu "
+                     "(replay with seed %llu)\nschedule:",
+                     r.reason, iteration,
+                     static_cast<unsigned long long>(seed));
+        for (auto id : r.schedule) {
+            std::fprintf(stderr, " %zu", id);
+        }
+        std::fprintf(stderr, "\n");
+    }
+
+  public:
+    test_scheduler(test_scheduler const &) = delete;
+    test_scheduler(test_scheduler &&) = delete;
+    auto operator=(test_scheduler const &) -> test_scheduler & = delete;
+    auto operator=(test_scheduler &&) -> test_scheduler & = delete;
+
+    ~test_scheduler() { join(); }
+
+    [[nodiscard]] static auto current() -> test_scheduler * {
+        return current_ref();
+    }
+
+    // spawn a thread whose execution is controlled by this scheduler: it does
+    // not run until join() is called
+    template <std::invocable F> auto spawn(F &&f) -> void {
+        std::lock_guard l{m};
+        auto const id = threads.size();
+        auto &t = threads.emplace_back();
+        t.priority = opts.pct_depth + rng() % (1u << 16u);
+        t.thread = std::thread{[this, id, f = std::forward<F>(f)]() mutable {
+            run_thread(id, f);
+        }};
+    }
+
+    // run spawned threads to completion, one at a time, switching between
+    // them only at scheduling points
+    auto join() -> void {
+        if (joined) {
+            return;
+        }
+        joined = true;
+        {
+            std::unique_lock l{m};
+            if (not threads.empty()) {
+                pick_next();
+                cv.notify_all();
+                cv.wait(l, [&] {
+                    return aborted or finished == threads.size();
+                });
+            }
+        }
+        for (auto &t : threads) {
+            t.thread.join();
+        }
+    }
+
+    // an explicit scheduling point for code outside critical sections
+    static auto yield() -> void {
+        if (auto *s = current(); s != nullptr) {
+            std::unique_lock l{s->m};
+            s->made_progress(this_thread());
+            s->switch_from(l, this_thread());
+        }
+    }
+
+    [[nodiscard]] auto failed() const -> bool { return reason != nullptr; }
+
+    // run body repeatedly under different schedules until it returns false
+    // (or a deadlock, step limit or exception is detected)
+    template <typename F>
+        requires std::invocable<F, test_scheduler &>
+    static auto explore(schedule_options const &opts, F &&body)
+        -> schedule_result {
+        schedule_result result{};
+        std::vector<choice> prefix{};
+        for (auto i = std::size_t{}; i < opts.iterations; ++i) {
+            auto const seed = opts.seed + i;
+            test_scheduler s{opts, seed, std::move(prefix)};
+            auto ok = true;
+            if constexpr (std::is_void_v<
+                              std::invoke_result_t<F, test_scheduler &>>) {
+                body(s);
+            } else {
+                ok = static_cast<bool>(body(s));
+            }
+            s.join();
+            ++result.iterations;
+
+            if (not ok) {
+                s.fail("check failed");
+            }
+            if (s.failed()) {
+                result.failed = true;
+                result.seed = seed;
+                result.reason = s.reason;
+                result.schedule = s.trace;
+                report(i, seed, result);
+                return result;
+            }
+
+            if (opts.strategy == schedule_strategy::exhaustive) {
+                prefix = s.next_prefix();
+                if (prefix.empty()) {
+                    result.exhausted = true;
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+};
+
+class deterministic_test_policy {
+    template <typename> static inline std::mutex m{};
+    template <typename> static inline char const key{};
+
+    template <typename Uniq> struct [[nodiscard]] cs_raii_t {
+        cs_raii_t(test_scheduler &sched, bool retry) : s{sched} {
+            s.lock(&key<Uniq>, retry);
+        }
+        ~cs_raii_t() { s.unlock(&key<Uniq>); }
+
+        cs_raii_t(cs_raii_t const &) = delete;
+        cs_raii_t(cs_raii_t &&) = delete;
+        auto operator=(cs_raii_t const &) -> cs_raii_t & = delete;
+        auto operator=(cs_raii_t &&) -> cs_raii_t & = delete;
+
+      private:
+        test_scheduler &s;
+    };
+
+  public:
+    template <typename Uniq = void, std::invocable F, std::predicate... Pred>
+        requires(sizeof...(Pred) < 2)
+    static inline auto call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(std::forward<F>(f)()) {
+        auto *s = test_scheduler::current();
+        if (s == nullptr) {
+            while (true) {
+                [[maybe_unused]] std::lock_guard l{m<Uniq>};
+                if ((... and pred())) {
+                    return std::forward<F>(f)();
+                }
+            }
+        }
+
+        for (auto retry = false;; retry = true) {
+            [[maybe_unused]] cs_raii_t<Uniq> lock{*s, retry};
+            if ((... and pred())) {
+                return std::forward<F>(f)();
+            }
+        }
+    }
+};
+
+template <> inline auto injected_policy<> = deterministic_test_policy{};
+} // namespace conc
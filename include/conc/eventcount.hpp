@@ -0,0 +1,89 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+#include <conc/parking_lot.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+
+namespace conc {
+// An eventcount lets a thread sleep until a condition over lock-free data
+// becomes true, without the signaling thread taking any lock. A waiter:
+//
+//   while (not condition()) {
+//       auto const key = ec.prepare_wait();
+//       if (condition()) {
+//           ec.cancel_wait();
+//           break;
+//       }
+//       ec.commit_wait(key);
+//   }
+//
+// and a signaler makes the condition true, then calls ec.notify(). When no
+// thread is waiting, notify() costs a fence and a load.
+//
+// The state packs an epoch (upper 32 bits), incremented by each notify() that
+// finds waiters, with the number of waiters (lower 32 bits), so preparing to
+// wait is a single atomic::fetch_add. Waiters sleep in the parking lot.
+class eventcount {
+    constexpr static auto epoch_shift = 32u;
+    constexpr static auto waiter_mask = (std::uint64_t{1} << epoch_shift) - 1;
+    constexpr static auto one_epoch = std::uint64_t{1} << epoch_shift;
+
+    std::uint64_t state{};
+
+  public:
+    class key {
+        friend class eventcount;
+        std::uint32_t epoch;
+        constexpr explicit key(std::uint32_t e) : epoch{e} {}
+    };
+
+    [[nodiscard]] auto prepare_wait() -> key {
+        auto const prev = atomic::fetch_add(state, std::uint64_t{1});
+        // order registering as a waiter before re-checking the condition
+        atomic::thread_fence(std::memory_order_seq_cst);
+        return key{static_cast<std::uint32_t>(prev >> epoch_shift)};
+    }
+
+    auto cancel_wait() -> void {
+        atomic::fetch_sub(state, std::uint64_t{1}, std::memory_order_relaxed);
+    }
+
+    // sleep until a notify() after the matching prepare_wait()
+    auto commit_wait(key k) -> void {
+        auto const notified = [&] {
+            return static_cast<std::uint32_t>(
+                       atomic::load(state, std::memory_order_acquire) >>
+                       epoch_shift) != k.epoch;
+        };
+        while (not notified()) {
+            park(this, [&] { return not notified(); });
+        }
+        atomic::fetch_sub(state, std::uint64_t{1}, std::memory_order_relaxed);
+    }
+
+    // wake every waiting thread
+    auto notify() -> void {
+        atomic::thread_fence(std::memory_order_seq_cst);
+        if ((atomic::load(state, std::memory_order_relaxed) & waiter_mask) !=
+            0) {
+            atomic::fetch_add(state, one_epoch, std::memory_order_acq_rel);
+            unpark_all(this);
+        }
+    }
+
+    // wait until pred() is true
+    template <std::predicate P> auto await(P &&pred) -> void {
+        while (not pred()) {
+            auto const k = prepare_wait();
+            if (pred()) {
+                cancel_wait();
+                return;
+            }
+            commit_wait(k);
+        }
+    }
+};
+} // namespace conc
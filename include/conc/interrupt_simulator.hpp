@@ -0,0 +1,252 @@
+#pragma once
+
+#include <conc/concurrency.hpp>
+#include <conc/detail/timestamp.hpp>
+
+#if __STDC_HOSTED__ == 0 or not __has_include(<pthread.h>) or                  \
+    not __has_include(<signal.h>)
+#error conc::interrupt_simulator is designed for desktop testing and requires a hosted POSIX implementation
+#endif
+
+#include <pthread.h>
+#include <signal.h>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <utility>
+
+namespace conc {
+// A critical section policy that behaves like disabling interrupts on a
+// microcontroller: it masks the simulated interrupt signal on the calling
+// thread. As with a global interrupt switch, the tag is ignored.
+template <int Signal = SIGUSR1> class interrupt_mask_policy {
+    static inline thread_local std::size_t depth{};
+    static inline std::atomic<std::uint64_t> longest{};
+
+    struct [[nodiscard]] critical_section {
+        critical_section() {
+            sigset_t s{};
+            sigemptyset(&s);
+            sigaddset(&s, Signal);
+            pthread_sigmask(SIG_BLOCK, &s, &old);
+            ++depth;
+        }
+        ~critical_section() {
+            --depth;
+            pthread_sigmask(SIG_SETMASK, &old, nullptr);
+        }
+
+        critical_section(critical_section const &) = delete;
+        critical_section(critical_section &&) = delete;
+        auto operator=(critical_section const &) -> critical_section & = delete;
+        auto operator=(critical_section &&) -> critical_section & = delete;
+
+      private:
+        sigset_t old{};
+    };
+
+  public:
+    template <typename = void, std::invocable F, std::predicate... Pred>
+        requires(sizeof...(Pred) < 2)
+    static auto call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(std::forward<F>(f)()) {
+        while (true) {
+            [[maybe_unused]] critical_section cs{};
+            auto const start = detail::steady_ns();
+            struct record_length {
+                std::uint64_t start;
+                ~record_length() {
+                    auto const len = detail::steady_ns() - start;
+                    auto prev = longest.load(std::memory_order_relaxed);
+                    while (prev < len and
+                           not longest.compare_exchange_weak(
+                               prev, len, std::memory_order_relaxed)) {
+                    }
+                }
+            } const r{start};
+            if ((... and pred())) {
+                return std::forward<F>(f)();
+            }
+        }
+    }
+
+    // for asserting that shared data is accessed under a critical section
+    [[nodiscard]] static auto in_critical_section() -> bool {
+        return depth != 0;
+    }
+
+    [[nodiscard]] static auto longest_section() -> std::chrono::nanoseconds {
+        return std::chrono::nanoseconds{longest.load()};
+    }
+    static auto reset_longest_section() -> void { longest = 0; }
+};
+
+struct interrupt_config {
+    std::chrono::nanoseconds period{std::chrono::microseconds{100}};
+    // each period is lengthened by a uniformly random [0, jitter)
+    std::chrono::nanoseconds jitter{};
+    std::uint64_t seed{};
+    int signal{SIGUSR1};
+};
+
+struct interrupt_stats {
+    // bucket i counts latencies in [2^i, 2^(i+1)) ns
+    constexpr static auto num_buckets = std::size_t{32};
+
+    std::uint64_t delivered{};
+    // interrupts raised while the previous one was still pending
+    std::uint64_t coalesced{};
+    std::chrono::nanoseconds max_latency{};
+    std::chrono::nanoseconds total_latency{};
+    std::array<std::uint64_t, num_buckets> histogram{};
+
+    [[nodiscard]] auto mean_latency() const -> std::chrono::nanoseconds {
+        return delivered == 0 ? std::chrono::nanoseconds{}
+                              : total_latency /
+                                    static_cast<std::int64_t>(delivered);
+    }
+};
+
+// Delivers "interrupts" to the thread that constructs it, as POSIX signals
+// raised from a generator thread. Each interrupt runs isr in signal context,
+// so isr must be async-signal-safe. Interrupt latency is measured from raising
+// the signal to entering the handler; masking the signal in a critical
+// section delays delivery just as disabling interrupts would. An interrupt
+// still pending when the simulator is destroyed is discarded.
+//
+// Only one simulator may be active at a time.
+class interrupt_simulator {
+    using isr_t = void (*)();
+
+    static inline std::atomic<isr_t> isr{};
+    static inline std::atomic<std::uint64_t> raised_at{};
+    static inline std::atomic<bool> pending{};
+    static inline std::atomic<std::uint64_t> delivered{};
+    static inline std::atomic<std::uint64_t> coalesced{};
+    static inline std::atomic<std::uint64_t> max_latency{};
+    static inline std::atomic<std::uint64_t> total_latency{};
+    static inline std::array<std::atomic<std::uint64_t>,
+                             interrupt_stats::num_buckets>
+        histogram{};
+    static inline thread_local bool in_handler{};
+
+    static auto handler(int) -> void {
+        auto const latency =
+            detail::steady_ns() - raised_at.load(std::memory_order_acquire);
+        pending.store(false, std::memory_order_release);
+
+        delivered.fetch_add(1, std::memory_order_relaxed);
+        total_latency.fetch_add(latency, std::memory_order_relaxed);
+        auto prev = max_latency.load(std::memory_order_relaxed);
+        while (prev < latency and not max_latency.compare_exchange_weak(
+                                      prev, latency,
+                                      std::memory_order_relaxed)) {
+        }
+        auto const bucket = latency == 0 ? 0u : std::bit_width(latency) - 1u;
+        histogram[std::min<std::size_t>(bucket, histogram.size() - 1)]
+            .fetch_add(1, std::memory_order_relaxed);
+
+        if (auto const f = isr.load(std::memory_order_acquire);
+            f != nullptr) {
+            in_handler = true;
+            f();
+            in_handler = false;
+        }
+    }
+
+    auto generate(std::stop_token stop) const -> void {
+        std::mt19937_64 rng{cfg.seed};
+        auto next = std::chrono::steady_clock::now();
+        while (not stop.stop_requested()) {
+            next += cfg.period;
+            if (cfg.jitter.count() > 0) {
+                next += std::chrono::nanoseconds{
+                    static_cast<std::int64_t>(
+                        rng() % static_cast<std::uint64_t>(cfg.jitter.count()))};
+            }
+            std::this_thread::sleep_until(next);
+
+            if (pending.exchange(true, std::memory_order_acq_rel)) {
+                coalesced.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            raised_at.store(detail::steady_ns(),
+                            std::memory_order_release);
+            pthread_kill(target, cfg.signal);
+        }
+    }
+
+    interrupt_config cfg;
+    pthread_t target{pthread_self()};
+    struct sigaction old_action{};
+    std::jthread generator{};
+
+  public:
+    explicit interrupt_simulator(isr_t f, interrupt_config const &c = {})
+        : cfg{c} {
+        reset_stats();
+        isr = f;
+
+        struct sigaction action{};
+        action.sa_handler = handler;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(cfg.signal, &action, &old_action);
+
+        generator = std::jthread{[this](std::stop_token s) { generate(s); }};
+    }
+
+    interrupt_simulator(interrupt_simulator const &) = delete;
+    interrupt_simulator(interrupt_simulator &&) = delete;
+    auto operator=(interrupt_simulator const &)
+        -> interrupt_simulator & = delete;
+    auto operator=(interrupt_simulator &&) -> interrupt_simulator & = delete;
+
+    ~interrupt_simulator() {
+        generator.request_stop();
+        generator.join();
+        // Discard an interrupt that was raised but not delivered (e.g.
+        // because this runs in a critical section), rather than wait for it:
+        // ignoring a pending signal discards it.
+        struct sigaction ignore{};
+        ignore.sa_handler = SIG_IGN;
+        sigemptyset(&ignore.sa_mask);
+        sigaction(cfg.signal, &ignore, nullptr);
+        sigaction(cfg.signal, &old_action, nullptr);
+        pending = false;
+        isr = nullptr;
+    }
+
+    // true when called from the simulated interrupt service routine
+    [[nodiscard]] static auto in_isr() -> bool { return in_handler; }
+
+    [[nodiscard]] static auto stats() -> interrupt_stats {
+        interrupt_stats s{};
+        s.delivered = delivered.load();
+        s.coalesced = coalesced.load();
+        s.max_latency = std::chrono::nanoseconds{max_latency.load()};
+        s.total_latency = std::chrono::nanoseconds{total_latency.load()};
+        for (auto i = std::size_t{}; i < histogram.size(); ++i) {
+            s.histogram[i] = histogram[i].load();
+        }
+        return s;
+    }
+
+    static auto reset_stats() -> void {
+        delivered = 0;
+        coalesced = 0;
+        max_latency = 0;
+        total_latency = 0;
+        for (auto &b : histogram) {
+            b = 0;
+        }
+    }
+};
+} // namespace conc
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+#include <conc/concurrency.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <utility>
+
+namespace conc {
+namespace detail {
+template <typename Tag>
+alignas(atomic::alignment_of<bool>) inline atomic::atomic_type_t<bool>
+    once_flag{};
+} // namespace detail
+
+// Call f exactly once for each Tag. After initialization, the cost of a call
+// is a single acquire load; only the first calls enter the critical section
+// identified by Tag. If f throws, a later call will try again.
+template <typename Tag, std::invocable F> auto call_once(F &&f) -> void {
+    auto &flag = detail::once_flag<Tag>;
+    if (atomic::load(flag, std::memory_order_acquire)) [[likely]] {
+        return;
+    }
+    call_in_critical_section<Tag>([&] {
+        if (not atomic::load(flag, std::memory_order_relaxed)) {
+            std::forward<F>(f)();
+            atomic::store(flag, true, std::memory_order_release);
+        }
+    });
+}
+
+// A value that is constructed on first access, under the critical section
+// identified by Tag.
+template <typename T, typename Tag = T> class lazy {
+    alignas(atomic::alignment_of<bool>) atomic::atomic_type_t<bool> flag{};
+    struct empty_t {};
+    union {
+        empty_t empty{};
+        T value;
+    };
+
+  public:
+    constexpr lazy() {}
+    lazy(lazy const &) = delete;
+    lazy(lazy &&) = delete;
+    auto operator=(lazy const &) -> lazy & = delete;
+    auto operator=(lazy &&) -> lazy & = delete;
+
+    ~lazy() {
+        if (atomic::load(flag, std::memory_order_acquire)) {
+            std::destroy_at(std::addressof(value));
+        }
+    }
+
+    // the arguments are used only by the call that constructs the value
+    template <typename... Args>
+        requires std::constructible_from<T, Args...>
+    auto get(Args &&...args) -> T & {
+        if (not atomic::load(flag, std::memory_order_acquire)) [[unlikely]] {
+            call_in_critical_section<Tag>([&] {
+                if (not atomic::load(flag, std::memory_order_relaxed)) {
+                    std::construct_at(std::addressof(value),
+                                      std::forward<Args>(args)...);
+                    atomic::store(flag, true, std::memory_order_release);
+                }
+            });
+        }
+        return value;
+    }
+
+    auto operator*() -> T & { return get(); }
+    auto operator->() -> T * { return std::addressof(get()); }
+
+    [[nodiscard]] auto has_value() const -> bool {
+        return atomic::load(flag, std::memory_order_acquire);
+    }
+};
+} // namespace conc
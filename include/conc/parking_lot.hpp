@@ -0,0 +1,119 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+
+#if __STDC_HOSTED__ == 0
+#error conc::park requires a hosted implementation
+#endif
+
+#if __has_include(<linux/futex.h>) and __has_include(<sys/syscall.h>)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define CONC_HAS_FUTEX 1
+#else
+#define CONC_HAS_FUTEX 0
+#endif
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace conc {
+namespace detail {
+// sleep while *addr == expected (or until woken, or spuriously)
+inline auto futex_wait(std::uint32_t &addr, std::uint32_t expected) -> void {
+#if CONC_HAS_FUTEX
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    syscall(SYS_futex, &addr, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr,
+            0);
+#else
+    std::atomic_ref{addr}.wait(expected, std::memory_order_seq_cst);
+#endif
+}
+
+inline auto futex_wake_all(std::uint32_t &addr) -> void {
+#if CONC_HAS_FUTEX
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    syscall(SYS_futex, &addr, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr,
+            0);
+#else
+    std::atomic_ref{addr}.notify_all();
+#endif
+}
+
+struct alignas(atomic::cache_line_size<>) parking_bucket {
+    std::uint32_t waiters{};
+    // the futex word: changes whenever waiters are woken
+    std::uint32_t epoch{};
+};
+
+constexpr auto parking_buckets = std::size_t{256};
+inline std::array<parking_bucket, parking_buckets> parking_table{};
+
+// 2^N / golden ratio, for Fibonacci hashing of an N-bit address
+constexpr inline auto fibonacci_multiplier = [] {
+    if constexpr (sizeof(std::uintptr_t) == sizeof(std::uint64_t)) {
+        return static_cast<std::uintptr_t>(0x9e37'79b9'7f4a'7c15u);
+    } else {
+        return static_cast<std::uintptr_t>(0x9e37'79b9u);
+    }
+}();
+
+inline auto bucket_for(void const *addr) -> parking_bucket & {
+    constexpr auto shift =
+        sizeof(std::uintptr_t) * CHAR_BIT -
+        static_cast<std::size_t>(std::countr_zero(parking_buckets));
+    auto const h = std::bit_cast<std::uintptr_t>(addr) * fibonacci_multiplier;
+    return parking_table[h >> shift];
+}
+} // namespace detail
+
+// Sleep on addr if validate() returns true; it is called after this thread is
+// registered as a waiter, so a call to unpark_all(addr) that follows a change
+// making validate() false cannot be missed. Returns after a call to
+// unpark_all(addr), or spuriously; the caller must re-check its condition.
+//
+// Waiters are kept in a global table of futexes hashed by address, so any
+// address can be used, but distinct addresses may share a bucket and wake
+// each other.
+template <std::predicate V> auto park(void const *addr, V &&validate) -> void {
+    auto &b = detail::bucket_for(addr);
+    atomic::fetch_add(b.waiters, 1u);
+    atomic::thread_fence(std::memory_order_seq_cst);
+    auto const epoch = atomic::load(b.epoch);
+    if (std::forward<V>(validate)()) {
+        detail::futex_wait(b.epoch, epoch);
+    }
+    atomic::fetch_sub(b.waiters, 1u, std::memory_order_relaxed);
+}
+
+// Wake all threads parked on addr (and any others sharing its bucket). When
+// no thread is parked in the bucket, this costs a fence and a load.
+inline auto unpark_all(void const *addr) -> void {
+    auto &b = detail::bucket_for(addr);
+    atomic::thread_fence(std::memory_order_seq_cst);
+    if (atomic::load(b.waiters, std::memory_order_relaxed) != 0) {
+        atomic::fetch_add(b.epoch, 1u);
+        detail::futex_wake_all(b.epoch);
+    }
+}
+
+// A wait_strategy that parks waiting threads instead of spinning, e.g. for
+// conc::barrier<conc::parking_wait>.
+struct parking_wait {
+    static auto wait(std::uint32_t const &w, std::uint32_t old) -> void {
+        park(&w, [&] {
+            return atomic::load(w, std::memory_order_acquire) == old;
+        });
+    }
+    static auto notify_all(std::uint32_t &w) -> void { unpark_all(&w); }
+};
+} // namespace conc
+
+#undef CONC_HAS_FUTEX
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <conc/concurrency.hpp>
+
+#if __STDC_HOSTED__ == 0 or not __has_include(<pthread.h>)
+#error conc::pi_mutex requires a hosted POSIX implementation
+#endif
+
+#include <pthread.h>
+
+#include <concepts>
+#include <mutex>
+#include <system_error>
+#include <utility>
+
+namespace conc {
+// A mutex with the priority-inheritance protocol: while a thread holds it, that
+// thread runs at (at least) the priority of the highest-priority thread waiting
+// for it. This bounds priority inversion for real-time (e.g. SCHED_FIFO)
+// threads, which std::mutex does not.
+//
+// Unlike std::mutex, construction is not constexpr; pi_mutex meets the
+// Lockable requirements, so it can be used with std::lock_guard.
+class pi_mutex {
+    pthread_mutex_t m{};
+
+    static auto check(int err, char const *what) -> void {
+        if (err != 0) {
+            throw std::system_error{err, std::generic_category(), what};
+        }
+    }
+
+  public:
+    // the attributes with which each pi_mutex is initialized
+    class attributes {
+        pthread_mutexattr_t attr{};
+
+      public:
+        attributes() {
+            check(pthread_mutexattr_init(&attr), "pthread_mutexattr_init");
+            auto const err =
+                pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+            if (err != 0) {
+                pthread_mutexattr_destroy(&attr);
+                check(err, "pthread_mutexattr_setprotocol");
+            }
+        }
+
+        attributes(attributes const &) = delete;
+        attributes(attributes &&) = delete;
+        auto operator=(attributes const &) -> attributes & = delete;
+        auto operator=(attributes &&) -> attributes & = delete;
+        ~attributes() { pthread_mutexattr_destroy(&attr); }
+
+        [[nodiscard]] auto native_handle() -> pthread_mutexattr_t * {
+            return &attr;
+        }
+    };
+
+    pi_mutex() {
+        attributes attr{};
+        check(pthread_mutex_init(&m, attr.native_handle()),
+              "pthread_mutex_init");
+    }
+
+    pi_mutex(pi_mutex const &) = delete;
+    pi_mutex(pi_mutex &&) = delete;
+    auto operator=(pi_mutex const &) -> pi_mutex & = delete;
+    auto operator=(pi_mutex &&) -> pi_mutex & = delete;
+    ~pi_mutex() { pthread_mutex_destroy(&m); }
+
+    auto lock() -> void { check(pthread_mutex_lock(&m), "pthread_mutex_lock"); }
+    [[nodiscard]] auto try_lock() -> bool {
+        return pthread_mutex_trylock(&m) == 0;
+    }
+    auto unlock() -> void { pthread_mutex_unlock(&m); }
+
+    [[nodiscard]] auto native_handle() -> pthread_mutex_t * { return &m; }
+};
+
+// The standard policy, with a priority-inheritance mutex for each tag. Each
+// mutex is constructed on first use, so a critical section may be entered
+// during the dynamic initialization of another translation unit.
+class priority_inheritance_policy {
+    template <typename> static auto mutex() -> pi_mutex & {
+        static pi_mutex m{};
+        return m;
+    }
+
+  public:
+    template <typename Uniq = void, std::invocable F, std::predicate... Pred>
+        requires(sizeof...(Pred) < 2)
+    static auto call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(std::forward<F>(f)()) {
+        while (true) {
+            [[maybe_unused]] std::lock_guard l{mutex<Uniq>()};
+            if ((... and pred())) {
+                return std::forward<F>(f)();
+            }
+        }
+    }
+};
+} // namespace conc
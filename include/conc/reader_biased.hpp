@@ -0,0 +1,196 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+#include <conc/concurrency.hpp>
+
+#if __STDC_HOSTED__ == 0
+#error conc::reader_biased_policy requires a hosted implementation
+#endif
+
+#if __has_include(<linux/membarrier.h>) and __has_include(<sys/syscall.h>)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define CONC_HAS_MEMBARRIER 1
+#else
+#define CONC_HAS_MEMBARRIER 0
+#endif
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace conc {
+namespace detail {
+// Register for expedited private membarrier once per process. If that fails
+// (or membarrier is not available at all), readers use the mutex.
+[[nodiscard]] inline auto membarrier_available() -> bool {
+#if CONC_HAS_MEMBARRIER
+    static auto const available = [] {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+        auto const cmds = syscall(SYS_membarrier, MEMBARRIER_CMD_QUERY, 0, 0);
+        return cmds >= 0 and
+               (cmds & MEMBARRIER_CMD_PRIVATE_EXPEDITED) != 0 and
+               // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+               syscall(SYS_membarrier,
+                       MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+// Issue a full memory barrier on every thread of this process
+inline auto membarrier() -> void {
+#if CONC_HAS_MEMBARRIER
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+#endif
+}
+} // namespace detail
+
+// A critical section policy for data that is read far more often than it is
+// written. A read section (see conc::call_in_read_section) only stores to a
+// per-thread flag, with a compiler fence; it executes no read-modify-write and
+// no memory fence. A writer (conc::call_in_critical_section) takes a mutex,
+// announces itself, and issues membarrier() to serialize with every reader
+// before waiting for readers in progress to finish.
+//
+// Each tag supports up to MaxReaders threads with reader flags; further
+// reader threads, and all readers when membarrier is unavailable, use the
+// mutex. A reader must not enter a critical section with the same tag.
+template <std::size_t MaxReaders = 64, typename Mutex = std::mutex>
+class reader_biased_policy {
+    struct alignas(atomic::cache_line_size<>) slot {
+        std::uint32_t depth{};
+        std::uint32_t claimed{};
+    };
+
+    struct state {
+        std::array<slot, MaxReaders> slots{};
+        Mutex m{};
+        alignas(atomic::cache_line_size<>) std::uint32_t writer{};
+    };
+
+    template <typename> static inline state s{};
+
+    struct slot_handle {
+        explicit slot_handle(std::array<slot, MaxReaders> &slots) {
+            for (auto &candidate : slots) {
+                auto expected = std::uint32_t{};
+                if (atomic::compare_exchange_strong(
+                        candidate.claimed, expected, 1u,
+                        std::memory_order_acquire,
+                        std::memory_order_relaxed)) {
+                    sl = &candidate;
+                    return;
+                }
+            }
+        }
+        ~slot_handle() {
+            if (sl != nullptr) {
+                atomic::store(sl->claimed, 0u, std::memory_order_release);
+            }
+        }
+        slot_handle(slot_handle const &) = delete;
+        slot_handle(slot_handle &&) = delete;
+        auto operator=(slot_handle const &) -> slot_handle & = delete;
+        auto operator=(slot_handle &&) -> slot_handle & = delete;
+
+        slot *sl{};
+    };
+
+    template <typename Tag> static auto local_slot() -> slot * {
+        thread_local slot_handle h{s<Tag>.slots};
+        return h.sl;
+    }
+
+    struct [[nodiscard]] read_raii_t {
+        explicit read_raii_t(slot &sl) : depth{sl.depth} {
+            atomic::store(depth, prev + 1, std::memory_order_relaxed);
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        }
+        ~read_raii_t() {
+            atomic::store(depth, prev, std::memory_order_release);
+        }
+        read_raii_t(read_raii_t const &) = delete;
+        read_raii_t(read_raii_t &&) = delete;
+        auto operator=(read_raii_t const &) -> read_raii_t & = delete;
+        auto operator=(read_raii_t &&) -> read_raii_t & = delete;
+
+        [[nodiscard]] auto nested() const -> bool { return prev != 0; }
+
+      private:
+        std::uint32_t &depth;
+        // only this thread writes its depth
+        std::uint32_t prev{depth};
+    };
+
+    template <typename Tag> struct [[nodiscard]] write_raii_t {
+        write_raii_t() {
+            atomic::store(s<Tag>.writer, 1u, std::memory_order_relaxed);
+            detail::membarrier();
+            // every reader now either sees the writer flag or has its depth
+            // visible here
+            for (auto &sl : s<Tag>.slots) {
+                while (atomic::load(sl.depth, std::memory_order_acquire) != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        ~write_raii_t() {
+            atomic::store(s<Tag>.writer, 0u, std::memory_order_release);
+        }
+        write_raii_t(write_raii_t const &) = delete;
+        write_raii_t(write_raii_t &&) = delete;
+        auto operator=(write_raii_t const &) -> write_raii_t & = delete;
+        auto operator=(write_raii_t &&) -> write_raii_t & = delete;
+    };
+
+  public:
+    template <typename Uniq = void, std::invocable F>
+    static auto call_in_read_section(F &&f) -> decltype(std::forward<F>(f)()) {
+        if (detail::membarrier_available()) [[likely]] {
+            if (auto *sl = local_slot<Uniq>(); sl != nullptr) [[likely]] {
+                [[maybe_unused]] read_raii_t r{*sl};
+                // a waiting writer also waits for an outer read section on
+                // this thread to finish, so a nested read can proceed
+                // acquire: see the writes of a writer that has just left
+                if (r.nested() or atomic::load(s<Uniq>.writer,
+                                               std::memory_order_acquire) == 0)
+                    [[likely]] {
+                    return std::forward<F>(f)();
+                }
+            }
+        }
+        [[maybe_unused]] std::lock_guard l{s<Uniq>.m};
+        return std::forward<F>(f)();
+    }
+
+    template <typename Uniq = void, std::invocable F, std::predicate... Pred>
+        requires(sizeof...(Pred) < 2)
+    static auto call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(std::forward<F>(f)()) {
+        while (true) {
+            [[maybe_unused]] std::lock_guard l{s<Uniq>.m};
+            // readers write nothing, so the mutex is enough to check the
+            // predicate; only wait for the readers once it holds
+            if ((... and pred())) {
+                if (detail::membarrier_available()) {
+                    [[maybe_unused]] write_raii_t<Uniq> w{};
+                    return std::forward<F>(f)();
+                }
+                return std::forward<F>(f)();
+            }
+        }
+    }
+};
+} // namespace conc
+
+#undef CONC_HAS_MEMBARRIER
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace conc {
+// An intrusive reference count, to be used as a base class of a shared object.
+// Unlike std::shared_ptr, nothing is seq_cst: taking a reference is a relaxed
+// increment (whoever copies a reference already holds one, so there is nothing
+// to order), and dropping one is a release decrement, with an acquire fence
+// only for the last, so that every access through another reference happens
+// before the object is destroyed.
+class refcount {
+    std::uint32_t count;
+
+  public:
+    // an object starts with one reference, owned by its creator
+    constexpr explicit refcount(std::uint32_t initial = 1) : count{initial} {}
+
+    refcount(refcount const &) = delete;
+    refcount(refcount &&) = delete;
+    auto operator=(refcount const &) -> refcount & = delete;
+    auto operator=(refcount &&) -> refcount & = delete;
+    ~refcount() = default;
+
+    auto add_ref() -> void {
+        atomic::fetch_add(count, 1u, std::memory_order_relaxed);
+    }
+
+    // true if this dropped the last reference: the caller must then destroy
+    // the object
+    [[nodiscard]] auto release() -> bool {
+        if (atomic::fetch_sub(count, 1u, std::memory_order_release) == 1) {
+            atomic::thread_fence(std::memory_order_acquire);
+            return true;
+        }
+        return false;
+    }
+
+    // only a hint while other threads hold references
+    [[nodiscard]] auto use_count() const -> std::uint32_t {
+        return atomic::load(count, std::memory_order_relaxed);
+    }
+};
+
+template <typename T>
+concept refcounted = requires(T &t) {
+    t.add_ref();
+    { t.release() } -> std::same_as<bool>;
+};
+
+struct delete_object {
+    template <typename T> auto operator()(T *t) const -> void { delete t; }
+};
+
+// A smart pointer to a refcounted object. Copying takes a reference; when the
+// last reference is dropped, the object is destroyed with Deleter.
+template <refcounted T, typename Deleter = delete_object> class intrusive_ptr {
+    T *p{};
+
+    auto drop() -> void {
+        if (p != nullptr and p->release()) {
+            Deleter{}(p);
+        }
+    }
+
+  public:
+    constexpr intrusive_ptr() = default;
+    constexpr explicit(false) intrusive_ptr(std::nullptr_t) {}
+
+    // adopts a reference already counted, e.g. the initial one of a new object
+    constexpr explicit intrusive_ptr(T *t) : p{t} {}
+
+    intrusive_ptr(intrusive_ptr const &other) : p{other.p} {
+        if (p != nullptr) {
+            p->add_ref();
+        }
+    }
+    constexpr intrusive_ptr(intrusive_ptr &&other) noexcept
+        : p{std::exchange(other.p, nullptr)} {}
+
+    auto operator=(intrusive_ptr const &other) -> intrusive_ptr & {
+        intrusive_ptr{other}.swap(*this);
+        return *this;
+    }
+    auto operator=(intrusive_ptr &&other) noexcept -> intrusive_ptr & {
+        intrusive_ptr{std::move(other)}.swap(*this);
+        return *this;
+    }
+    ~intrusive_ptr() { drop(); }
+
+    auto reset() -> void {
+        drop();
+        p = nullptr;
+    }
+    constexpr auto swap(intrusive_ptr &other) noexcept -> void {
+        std::swap(p, other.p);
+    }
+
+    // give up the reference without dropping it
+    [[nodiscard]] constexpr auto detach() -> T * {
+        return std::exchange(p, nullptr);
+    }
+
+    [[nodiscard]] constexpr auto get() const -> T * { return p; }
+    constexpr auto operator*() const -> T & { return *p; }
+    constexpr auto operator->() const -> T * { return p; }
+    constexpr explicit operator bool() const { return p != nullptr; }
+
+    friend constexpr auto operator==(intrusive_ptr const &,
+                                     intrusive_ptr const &) -> bool = default;
+    friend constexpr auto operator==(intrusive_ptr const &x, std::nullptr_t)
+        -> bool {
+        return x.p == nullptr;
+    }
+};
+
+template <refcounted T, typename... Args>
+[[nodiscard]] auto make_intrusive(Args &&...args) -> intrusive_ptr<T> {
+    return intrusive_ptr<T>{new T(std::forward<Args>(args)...)};
+}
+} // namespace conc
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <conc/concurrency.hpp>
+#include <conc/detail/thread_log.hpp>
+#include <conc/detail/timestamp.hpp>
+
+#if __STDC_HOSTED__ == 0
+#error conc::tracing_policy is designed for desktop profiling and requires a hosted implementation
+#endif
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace conc {
+namespace detail {
+template <typename T> constexpr auto type_name() -> std::string_view {
+    constexpr auto f = std::string_view{__PRETTY_FUNCTION__};
+    constexpr auto start = f.find("T = ") + 4;
+    constexpr auto end = std::min(f.find(';', start), f.rfind(']'));
+    return f.substr(start, end - start);
+}
+
+// an object with a distinct address for each tag type
+template <typename> constexpr inline char tag_id{};
+
+inline auto write_json_escaped(std::ostream &os, std::string_view s) -> void {
+    for (auto c : s) {
+        if (c == '"' or c == '\\') {
+            os << '\\';
+        }
+        os << c;
+    }
+}
+
+// write a non-negative number of nanoseconds as microseconds
+inline auto write_us(std::ostream &os, std::uint64_t ns) -> void {
+    auto const frac = ns % 1'000u;
+    os << ns / 1'000u << '.' << static_cast<char>('0' + frac / 100u)
+       << static_cast<char>('0' + frac / 10u % 10u)
+       << static_cast<char>('0' + frac % 10u);
+}
+} // namespace detail
+
+enum struct trace_kind : std::uint8_t { enter, acquire, release };
+
+struct trace_event {
+    std::uint64_t timestamp{};
+    // the name of the critical section's tag type
+    std::string_view name{};
+    // identifies the tag type: unlike the name, this differs between the tags
+    // of untagged call sites
+    void const *tag{};
+    trace_kind kind{};
+};
+
+// A critical section policy that forwards to Base and records, for each
+// critical section, when it was entered, when the lock was acquired, and when
+// it was released. Events go into a per-thread ring buffer of the most recent
+// Capacity events, timestamped with the time-stamp counter, so recording an
+// event costs a few stores and no synchronization.
+//
+// write_chrome_trace() exports the events in Chrome trace-event JSON, which
+// can be loaded into Perfetto or chrome://tracing to visualize lock convoys.
+template <typename Base = standard_policy<>,
+          std::size_t Capacity = std::size_t{1} << 14u>
+class tracing_policy {
+    using log_t = detail::thread_log<trace_event, Capacity, tracing_policy,
+                                     detail::log_mode::overwrite_oldest>;
+
+    template <typename Uniq> static auto record(trace_kind kind) -> void {
+        // the first event on a thread allocates its ring; don't time that
+        log_t::append_with([&] {
+            return trace_event{.timestamp = detail::timestamp(),
+                               .name = detail::type_name<Uniq>(),
+                               .tag = &detail::tag_id<Uniq>,
+                               .kind = kind};
+        });
+    }
+
+  public:
+    template <typename Uniq = void, std::invocable F, std::predicate... Pred>
+        requires(sizeof...(Pred) < 2)
+    static auto call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(std::forward<F>(f)()) {
+        record<Uniq>(trace_kind::enter);
+        return Base::template call_in_critical_section<Uniq>(
+            [&]() -> decltype(std::forward<F>(f)()) {
+                record<Uniq>(trace_kind::acquire);
+                struct release_t {
+                    release_t() = default;
+                    release_t(release_t const &) = delete;
+                    release_t(release_t &&) = delete;
+                    auto operator=(release_t const &) -> release_t & = delete;
+                    auto operator=(release_t &&) -> release_t & = delete;
+                    ~release_t() { record<Uniq>(trace_kind::release); }
+                } const r{};
+                return std::forward<F>(f)();
+            },
+            std::forward<Pred>(pred)...);
+    }
+
+    // call f(thread_id, trace_event) for each recorded event, in per-thread
+    // order; only call while no thread is in a critical section
+    template <typename F> static auto for_each(F &&f) -> void {
+        log_t::for_each(std::forward<F>(f));
+    }
+
+    // Write all recorded events as Chrome trace-event JSON. Each critical
+    // section appears as a "wait" slice followed by a slice for the time the
+    // lock was held, on the thread that entered it. Distinct tags with the
+    // same name (e.g. those of untagged call sites) are numbered: "name #1",
+    // "name #2", ...
+    static auto write_chrome_trace(std::ostream &os) -> void {
+        auto origin = std::numeric_limits<std::uint64_t>::max();
+        std::map<std::string_view, std::vector<void const *>> tags{};
+        log_t::for_each([&](auto, trace_event const &e) {
+            origin = std::min(origin, e.timestamp);
+            auto &same_name = tags[e.name];
+            if (std::find(same_name.begin(), same_name.end(), e.tag) ==
+                same_name.end()) {
+                same_name.push_back(e.tag);
+            }
+        });
+        auto const ticks_per_us = detail::timestamp_ticks_per_us();
+
+        os << R"({"displayTimeUnit":"ns","traceEvents":[)";
+        auto first = true;
+        auto const write_event = [&](std::size_t tid, trace_event const &e,
+                                     char phase, std::string_view suffix) {
+            os << (first ? "\n" : ",\n") << R"({"name":")";
+            first = false;
+            detail::write_json_escaped(os, e.name);
+            if (auto const &same_name = tags[e.name]; same_name.size() > 1) {
+                os << " #"
+                   << std::find(same_name.begin(), same_name.end(), e.tag) -
+                          same_name.begin() + 1;
+            }
+            os << suffix << R"(","cat":"lock","ph":")" << phase
+               << R"(","ts":)";
+            detail::write_us(os, static_cast<std::uint64_t>(
+                                     static_cast<double>(e.timestamp - origin) *
+                                     1'000.0 / ticks_per_us));
+            os << R"(,"pid":1,"tid":)" << tid << '}';
+        };
+
+        // a ring may have overwritten the start of a thread's outer critical
+        // sections; skip events of sections that were entered before that
+        auto current = std::numeric_limits<std::size_t>::max();
+        auto depth = std::size_t{};
+        log_t::for_each([&](std::size_t tid, trace_event const &e) {
+            if (tid != current) {
+                current = tid;
+                depth = 0;
+            }
+            switch (e.kind) {
+            case trace_kind::enter:
+                ++depth;
+                write_event(tid, e, 'B', " (wait)");
+                break;
+            case trace_kind::acquire:
+                if (depth != 0) {
+                    write_event(tid, e, 'E', " (wait)");
+                    write_event(tid, e, 'B', "");
+                }
+                break;
+            case trace_kind::release:
+                if (depth != 0) {
+                    --depth;
+                    write_event(tid, e, 'E', "");
+                }
+                break;
+            }
+        });
+        os << "\n]}\n";
+    }
+
+    // events overwritten because a thread's ring was full
+    [[nodiscard]] static auto dropped() -> std::size_t {
+        return log_t::dropped();
+    }
+
+    // only call while no thread is in a critical section
+    static auto reset() -> void { log_t::reset(); }
+};
+} // namespace conc
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace conc {
+// A wait-free channel for the latest value of T, between one producer thread
+// and one consumer thread. There are three buffers: the producer writes to its
+// back buffer and the consumer reads from its front buffer, so values are
+// copied without any lock. Publishing swaps the back buffer with the middle
+// buffer, and the consumer swaps the middle buffer with its front buffer when
+// there is a newer value; each swap is a single atomic::exchange of a word
+// that packs the middle buffer's index with a "dirty" bit.
+//
+// Values are never queued: the consumer sees only the most recent value
+// published before it calls read() (or update()).
+template <typename T> class triple_buffer {
+    constexpr static auto index_mask = std::uint8_t{0b011u};
+    constexpr static auto dirty_bit = std::uint8_t{0b100u};
+
+    struct alignas(atomic::cache_line_size<>) slot {
+        T value{};
+    };
+
+    std::array<slot, 3> buffers{};
+    alignas(atomic::cache_line_size<>)
+        alignas(atomic::alignment_of<std::uint8_t>)
+            atomic::atomic_type_t<std::uint8_t> middle{1};
+    // owned by the producer
+    alignas(atomic::cache_line_size<>) std::uint8_t back{0};
+    // owned by the consumer
+    alignas(atomic::cache_line_size<>) std::uint8_t front{2};
+
+  public:
+    constexpr triple_buffer() = default;
+    constexpr explicit triple_buffer(T const &initial)
+        : buffers{slot{initial}, slot{initial}, slot{initial}} {}
+
+    // producer: the buffer to fill before calling publish()
+    [[nodiscard]] auto write_buffer() -> T & { return buffers[back].value; }
+
+    // producer: make the contents of write_buffer() the latest value
+    auto publish() -> void {
+        auto const prev = atomic::exchange(
+            middle, static_cast<std::uint8_t>(back | dirty_bit),
+            std::memory_order_acq_rel);
+        back = static_cast<std::uint8_t>(prev & index_mask);
+    }
+
+    // producer
+    auto write(T const &t) -> void {
+        write_buffer() = t;
+        publish();
+    }
+
+    // consumer: true if a value was published since the last update
+    [[nodiscard]] auto has_update() const -> bool {
+        return (atomic::load(middle, std::memory_order_relaxed) & dirty_bit) !=
+               0;
+    }
+
+    // consumer: take the latest value, if there is a new one; returns whether
+    // there was
+    auto update() -> bool {
+        if (not has_update()) {
+            return false;
+        }
+        auto const prev =
+            atomic::exchange(middle, front, std::memory_order_acq_rel);
+        front = static_cast<std::uint8_t>(prev & index_mask);
+        return true;
+    }
+
+    // consumer: the latest value; valid until the next call to read() or
+    // update()
+    [[nodiscard]] auto read() -> T const & {
+        update();
+        return buffers[front].value;
+    }
+
+    // consumer: the value taken by the last update, without checking for a
+    // newer one
+    [[nodiscard]] auto current() const -> T const & {
+        return buffers[front].value;
+    }
+};
+} // namespace conc
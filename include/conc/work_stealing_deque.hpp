@@ -0,0 +1,149 @@
+#pragma once
+
+#include <conc/atomic.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace conc {
+// A Chase-Lev work-stealing deque (following Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models", PPoPP 2013).
+//
+// One owner thread may push() and take() at the bottom; any thread may
+// steal() from the top. Only steal(), and take() of the last element, use a
+// compare-exchange. The circular array grows as necessary; retired arrays are
+// kept until the deque is destroyed, since a thief may still be reading one.
+//
+// Elements are read concurrently with writes and are copied with atomic
+// operations, so T must be trivially copyable and should be lock-free.
+template <typename T> class work_stealing_deque {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "work_stealing_deque elements must be trivially copyable");
+
+    using index_t = std::ptrdiff_t;
+
+    struct array {
+        explicit array(index_t cap)
+            : capacity{cap}, slots{std::make_unique<T[]>(
+                                 static_cast<std::size_t>(cap))} {}
+
+        [[nodiscard]] auto slot(index_t i) const -> T & {
+            return slots[static_cast<std::size_t>(i & (capacity - 1))];
+        }
+        [[nodiscard]] auto get(index_t i) const -> T {
+            return atomic::load(slot(i), std::memory_order_relaxed);
+        }
+        auto put(index_t i, T t) const -> void {
+            atomic::store(slot(i), t, std::memory_order_relaxed);
+        }
+
+        index_t capacity;
+        std::unique_ptr<T[]> slots;
+    };
+
+    std::vector<std::unique_ptr<array>> arrays{};
+    alignas(atomic::cache_line_size<>) index_t top{};
+    alignas(atomic::cache_line_size<>) index_t bottom{};
+    alignas(atomic::cache_line_size<>) array *current;
+
+    auto grow(array *a, index_t t, index_t b) -> array * {
+        auto &next =
+            arrays.emplace_back(std::make_unique<array>(a->capacity * 2));
+        for (auto i = t; i < b; ++i) {
+            next->put(i, a->get(i));
+        }
+        return next.get();
+    }
+
+  public:
+    // capacity is rounded up to a power of two
+    explicit work_stealing_deque(std::size_t capacity = 64)
+        : current{arrays
+                      .emplace_back(std::make_unique<array>(
+                          static_cast<index_t>(std::bit_ceil(
+                              std::max(capacity, std::size_t{2})))))
+                      .get()} {}
+
+    work_stealing_deque(work_stealing_deque const &) = delete;
+    work_stealing_deque(work_stealing_deque &&) = delete;
+    auto operator=(work_stealing_deque const &)
+        -> work_stealing_deque & = delete;
+    auto operator=(work_stealing_deque &&) -> work_stealing_deque & = delete;
+    ~work_stealing_deque() = default;
+
+    // owner only
+    auto push(T t) -> void {
+        auto const b = atomic::load(bottom, std::memory_order_relaxed);
+        auto const tp = atomic::load(top, std::memory_order_acquire);
+        auto *a = atomic::load(current, std::memory_order_relaxed);
+        if (b - tp > a->capacity - 1) {
+            a = grow(a, tp, b);
+            atomic::store(current, a, std::memory_order_release);
+        }
+        a->put(b, t);
+        atomic::thread_fence(std::memory_order_release);
+        atomic::store(bottom, b + 1, std::memory_order_relaxed);
+    }
+
+    // owner only: LIFO
+    [[nodiscard]] auto take() -> std::optional<T> {
+        auto const b = atomic::load(bottom, std::memory_order_relaxed) - 1;
+        auto *a = atomic::load(current, std::memory_order_relaxed);
+        atomic::store(bottom, b, std::memory_order_relaxed);
+        atomic::thread_fence(std::memory_order_seq_cst);
+        auto t = atomic::load(top, std::memory_order_relaxed);
+
+        if (t > b) {
+            atomic::store(bottom, b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        auto x = std::optional<T>{a->get(b)};
+        if (t == b) {
+            // the last element: race against thieves for it
+            if (not atomic::compare_exchange_strong(
+                    top, t, t + 1, std::memory_order_seq_cst,
+                    std::memory_order_relaxed)) {
+                x.reset();
+            }
+            atomic::store(bottom, b + 1, std::memory_order_relaxed);
+        }
+        return x;
+    }
+
+    // any thread: FIFO. Returns nullopt if the deque is empty, or if another
+    // thread won the race for the top element.
+    [[nodiscard]] auto steal() -> std::optional<T> {
+        auto t = atomic::load(top, std::memory_order_acquire);
+        atomic::thread_fence(std::memory_order_seq_cst);
+        auto const b = atomic::load(bottom, std::memory_order_acquire);
+        if (t >= b) {
+            return std::nullopt;
+        }
+
+        auto *a = atomic::load(current, std::memory_order_acquire);
+        auto const x = a->get(t);
+        if (not atomic::compare_exchange_strong(top, t, t + 1,
+                                                std::memory_order_seq_cst,
+                                                std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return x;
+    }
+
+    // approximate when called concurrently with other operations
+    [[nodiscard]] auto size() const -> std::size_t {
+        auto const b = atomic::load(bottom, std::memory_order_relaxed);
+        auto const t = atomic::load(top, std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+    [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+};
+} // namespace conc
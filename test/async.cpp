@@ -0,0 +1,226 @@
+#include <conc/async.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+// a minimal eagerly-started coroutine type. Coroutine lambdas are named so
+// that their captures outlive a suspension.
+struct task {
+    struct promise_type {
+        auto get_return_object() -> task {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        auto initial_suspend() -> std::suspend_never { return {}; }
+        auto final_suspend() noexcept -> std::suspend_always { return {}; }
+        auto return_void() -> void {}
+        auto unhandled_exception() -> void { std::terminate(); }
+    };
+
+    task(std::coroutine_handle<promise_type> handle) : h{handle} {}
+    task(task const &) = delete;
+    task(task &&other) noexcept : h{std::exchange(other.h, {})} {}
+    auto operator=(task const &) -> task & = delete;
+    auto operator=(task &&) -> task & = delete;
+    ~task() {
+        if (h) {
+            h.destroy();
+        }
+    }
+
+    [[nodiscard]] auto done() const -> bool { return h.done(); }
+
+    std::coroutine_handle<promise_type> h;
+};
+
+// co_await e.wait() suspends until e.set()
+struct event {
+    struct awaiter {
+        event *e;
+        auto await_ready() const -> bool { return false; }
+        auto await_suspend(std::coroutine_handle<> h) -> void { e->waiter = h; }
+        auto await_resume() const -> void {}
+    };
+
+    auto wait() -> awaiter { return {this}; }
+    auto set() -> void { std::exchange(waiter, {}).resume(); }
+
+    std::coroutine_handle<> waiter{};
+};
+
+struct queue_executor {
+    std::deque<std::coroutine_handle<>> *q;
+    auto operator()(std::coroutine_handle<> h) const -> void {
+        q->push_back(h);
+    }
+};
+} // namespace
+
+TEST_CASE("executors model concept", "[async]") {
+    STATIC_REQUIRE(conc::executor<conc::inline_executor>);
+    STATIC_REQUIRE(conc::executor<queue_executor>);
+    STATIC_REQUIRE(not conc::executor<int>);
+}
+
+TEST_CASE("an uncontended lock does not suspend", "[async]") {
+    struct tag;
+    auto locked = false;
+    auto t_fn = [&]() -> task {
+        auto g = co_await conc::lock<tag>();
+        locked = g.owns_lock();
+    };
+    auto t = t_fn();
+    CHECK(t.done());
+    CHECK(locked);
+}
+
+TEST_CASE("a contended lock resumes the waiter on unlock", "[async]") {
+    struct tag;
+    event e{};
+    std::vector<int> order{};
+
+    auto holder_fn = [&]() -> task {
+        auto g = co_await conc::lock<tag>();
+        order.push_back(1);
+        co_await e.wait();
+        order.push_back(2);
+    };
+    auto holder = holder_fn();
+    auto waiter_fn = [&]() -> task {
+        auto g = co_await conc::lock<tag>();
+        order.push_back(3);
+    };
+    auto waiter = waiter_fn();
+
+    CHECK(not holder.done());
+    CHECK(not waiter.done());
+    e.set();
+    CHECK(holder.done());
+    CHECK(waiter.done());
+    CHECK(order == std::vector{1, 2, 3});
+}
+
+TEST_CASE("waiters are resumed in FIFO order", "[async]") {
+    struct tag;
+    event e{};
+    std::vector<int> order{};
+
+    auto holder_fn = [&]() -> task {
+        auto g = co_await conc::lock<tag>();
+        co_await e.wait();
+    };
+    auto holder = holder_fn();
+    auto waiter = [&](int id) -> task {
+        auto g = co_await conc::lock<tag>();
+        order.push_back(id);
+    };
+    auto w1 = waiter(1);
+    auto w2 = waiter(2);
+    auto w3 = waiter(3);
+    e.set();
+    CHECK(order == std::vector{1, 2, 3});
+}
+
+TEST_CASE("an async critical section returns a value", "[async]") {
+    auto value = 0;
+    auto t_fn = [&]() -> task {
+        value =
+            co_await conc::call_in_critical_section_async([] { return 17; });
+    };
+    auto t = t_fn();
+    CHECK(t.done());
+    CHECK(value == 17);
+}
+
+TEST_CASE("an async critical section waits for its predicate", "[async]") {
+    struct tag;
+    event e{};
+    auto ready = false;
+    auto ran = false;
+
+    auto setter_fn = [&]() -> task {
+        auto g = co_await conc::lock<tag>();
+        co_await e.wait();
+        ready = true;
+    };
+    auto setter = setter_fn();
+    auto waiter_fn = [&]() -> task {
+        co_await conc::call_in_critical_section_async<tag>(
+            [&] { ran = true; }, [&] { return ready; });
+    };
+    auto waiter = waiter_fn();
+
+    CHECK(not waiter.done());
+    e.set();
+    CHECK(setter.done());
+    CHECK(waiter.done());
+    CHECK(ran);
+}
+
+TEST_CASE("a waiter may be resumed on an executor", "[async]") {
+    struct tag;
+    event e{};
+    std::deque<std::coroutine_handle<>> q{};
+
+    auto holder_fn = [&]() -> task {
+        auto g = co_await conc::lock<tag>();
+        co_await e.wait();
+    };
+    auto holder = holder_fn();
+    auto waiter_fn = [&]() -> task {
+        auto g = co_await conc::lock<tag>(queue_executor{&q});
+    };
+    auto waiter = waiter_fn();
+
+    e.set();
+    CHECK(holder.done());
+    CHECK(not waiter.done());
+    REQUIRE(q.size() == 1);
+    q.front().resume();
+    CHECK(waiter.done());
+}
+
+TEST_CASE("async critical sections exclude each other across threads",
+          "[async]") {
+    struct tag;
+    constexpr auto threads = 4u;
+    constexpr auto iterations = 10'000u;
+    std::uint64_t count{};
+
+    auto increment = [&]() -> task {
+        for (auto i = 0u; i < iterations; ++i) {
+            co_await conc::call_in_critical_section_async<tag>(
+                [&] { ++count; });
+        }
+    };
+
+    // a task may finish on whichever thread hands it the lock, but never
+    // after that thread has been joined
+    std::vector<std::optional<task>> tasks(threads);
+    std::atomic<std::uint32_t> started{};
+    std::vector<std::thread> ts{};
+    for (auto i = 0u; i < threads; ++i) {
+        ts.emplace_back([&, i] {
+            ++started;
+            while (started < threads) {
+            }
+            tasks[i].emplace(increment());
+        });
+    }
+    for (auto &t : ts) {
+        t.join();
+    }
+    for (auto const &t : tasks) {
+        CHECK(t->done());
+    }
+    CHECK(count == threads * iterations);
+}
@@ -0,0 +1,127 @@
+#include <conc/atomic.hpp>
+#include <conc/atomic_fallback.hpp>
+#include <conc/concepts.hpp>
+#include <conc/concurrency.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <utility>
+
+namespace {
+struct big {
+    std::array<std::uint32_t, 8> data{};
+    friend auto operator==(big const &, big const &) -> bool = default;
+};
+
+// 8 bytes, but only 4-byte aligned
+struct under_aligned {
+    std::uint32_t lo{};
+    std::uint32_t hi{};
+    friend auto operator==(under_aligned const &, under_aligned const &)
+        -> bool = default;
+};
+
+struct counting_policy {
+    static inline std::uint64_t count{};
+
+    template <typename = void, std::invocable F, std::predicate... Pred>
+        requires(sizeof...(Pred) < 2)
+    static auto call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(std::forward<F>(f)()) {
+        ++count;
+        return conc::detail::standard_policy<>::call_in_critical_section(
+            std::forward<F>(f), std::forward<Pred>(pred)...);
+    }
+};
+
+struct never_lock_free_policy : atomic::detail::standard_policy {
+    template <typename> constexpr static auto is_always_lock_free() -> bool {
+        return false;
+    }
+};
+} // namespace
+
+template <> inline auto conc::injected_policy<> = counting_policy{};
+
+template <typename T>
+inline auto atomic::fallback_policy<T> = atomic::critical_section_policy{};
+
+// strict mode is satisfied because big has a fallback policy
+template <> constexpr inline auto atomic::strict_lock_free<> = true;
+
+TEST_CASE("lock-freedom is known at compile time", "[atomic_lock_free]") {
+    STATIC_REQUIRE(atomic::is_always_lock_free<std::uint32_t>);
+    STATIC_REQUIRE(atomic::is_always_lock_free<void *>);
+    STATIC_REQUIRE(not atomic::is_always_lock_free<big>);
+}
+
+TEST_CASE("lock-freedom takes alignment into account", "[atomic_lock_free]") {
+    STATIC_REQUIRE(sizeof(under_aligned) == sizeof(std::uint64_t));
+    STATIC_REQUIRE(alignof(under_aligned) < sizeof(under_aligned));
+    STATIC_REQUIRE(atomic::is_always_lock_free<std::uint64_t>);
+    STATIC_REQUIRE(not atomic::is_always_lock_free<under_aligned>);
+}
+
+TEST_CASE("under-aligned types use the fallback policy", "[atomic_lock_free]") {
+    auto const c = counting_policy::count;
+    under_aligned u{};
+    atomic::store(u, under_aligned{1, 2});
+    CHECK(atomic::load(u) == under_aligned{1, 2});
+    CHECK(counting_policy::count - c == 2);
+}
+
+TEST_CASE("a policy can declare what is lock-free", "[atomic_lock_free]") {
+    STATIC_REQUIRE(atomic::is_always_lock_free<
+                   std::uint32_t, atomic::detail::standard_policy>);
+    STATIC_REQUIRE(
+        not atomic::is_always_lock_free<std::uint32_t, never_lock_free_policy>);
+    STATIC_REQUIRE(not atomic::is_always_lock_free<
+                   std::uint32_t, atomic::critical_section_policy<>>);
+}
+
+TEST_CASE("critical section policy models concepts", "[atomic_lock_free]") {
+    using P = atomic::critical_section_policy<>;
+    STATIC_REQUIRE(atomic::policy<P>);
+    STATIC_REQUIRE(atomic::compare_exchange_policy<P>);
+    STATIC_REQUIRE(atomic::fence_policy<P>);
+}
+
+TEST_CASE("lock-free operations use the injected policy",
+          "[atomic_lock_free]") {
+    auto const c = counting_policy::count;
+    std::uint32_t val{17};
+    atomic::store(val, 1337);
+    CHECK(atomic::load(val) == 1337);
+    CHECK(counting_policy::count == c);
+}
+
+TEST_CASE("other operations use the fallback policy", "[atomic_lock_free]") {
+    auto const c = counting_policy::count;
+    big b{};
+    auto const x = big{{1, 2, 3, 4, 5, 6, 7, 8}};
+    atomic::store(b, x);
+    CHECK(atomic::load(b) == x);
+    CHECK(atomic::exchange(b, big{}) == x);
+    CHECK(counting_policy::count - c == 3);
+
+    auto expected = x;
+    CHECK(not atomic::compare_exchange_strong(b, expected, x));
+    CHECK(expected == big{});
+    CHECK(atomic::compare_exchange_strong(b, expected, x));
+    CHECK(atomic::load(b) == x);
+}
+
+TEST_CASE("fallback policy implements read-modify-write operations",
+          "[atomic_lock_free]") {
+    using P = atomic::critical_section_policy<>;
+    std::uint32_t val{17};
+    CHECK(P::fetch_add(val, 3u) == 17);
+    CHECK(P::fetch_sub(val, 1u) == 20);
+    CHECK(P::fetch_and(val, 0xfu) == 19);
+    CHECK(P::fetch_or(val, 0x10u) == 3);
+    CHECK(P::fetch_xor(val, 0x1u) == 0x13);
+    CHECK(val == 0x12);
+}
@@ -0,0 +1,299 @@
+#include <conc/atomic_recording.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <thread>
+#include <vector>
+
+template <>
+inline auto atomic::injected_policy<> = atomic::recording_policy<>{};
+
+TEST_CASE("recording policy models concepts", "[atomic_recording_policy]") {
+    STATIC_REQUIRE(atomic::policy<atomic::recording_policy<>>);
+    STATIC_REQUIRE(atomic::compare_exchange_policy<atomic::recording_policy<>>);
+    STATIC_REQUIRE(atomic::fence_policy<atomic::recording_policy<>>);
+}
+
+TEST_CASE("recording policy records loads and stores",
+          "[atomic_recording_policy]") {
+    atomic::recorder::reset();
+    std::uint32_t val{17};
+    atomic::store(val, 1337, std::memory_order_release);
+    CHECK(atomic::load(val, std::memory_order_acquire) == 1337);
+
+    auto const h = atomic::recorder::collect();
+    REQUIRE(h.size() == 2);
+    CHECK(h[0].kind == atomic::op::store);
+    CHECK(h[0].address == &val);
+    CHECK(h[0].written == 1337);
+    CHECK(h[0].order == std::memory_order_release);
+    CHECK(h[1].kind == atomic::op::load);
+    CHECK(h[1].read == 1337);
+    CHECK(h[1].order == std::memory_order_acquire);
+    CHECK(h[0].thread == h[1].thread);
+    CHECK(h[0].begin <= h[0].end);
+    CHECK(h[0].begin <= h[1].begin);
+}
+
+TEST_CASE("recording policy records read-modify-writes",
+          "[atomic_recording_policy]") {
+    atomic::recorder::reset();
+    std::uint32_t val{17};
+    CHECK(atomic::fetch_add(val, 1) == 17);
+    CHECK(atomic::exchange(val, 1337) == 18);
+    CHECK(atomic::fetch_xor(val, 1) == 1337);
+
+    auto const h = atomic::recorder::collect();
+    REQUIRE(h.size() == 3);
+    CHECK(h[0].kind == atomic::op::fetch_add);
+    CHECK(h[0].read == 17);
+    CHECK(h[0].written == 18);
+    CHECK(h[1].kind == atomic::op::exchange);
+    CHECK(h[1].read == 18);
+    CHECK(h[1].written == 1337);
+    CHECK(h[2].kind == atomic::op::fetch_xor);
+    CHECK(h[2].written == 1336);
+}
+
+TEST_CASE("recording policy records compare-exchanges and fences",
+          "[atomic_recording_policy]") {
+    atomic::recorder::reset();
+    std::uint32_t val{17};
+    std::uint32_t expected{17};
+    CHECK(atomic::compare_exchange_strong(val, expected, 18));
+    CHECK(not atomic::compare_exchange_strong(val, expected, 19));
+    atomic::thread_fence(std::memory_order_release);
+
+    auto const h = atomic::recorder::collect();
+    REQUIRE(h.size() == 3);
+    CHECK(h[0].kind == atomic::op::compare_exchange);
+    CHECK(h[0].read == 17);
+    CHECK(h[0].written == 18);
+    CHECK(h[1].kind == atomic::op::load);
+    CHECK(h[1].read == 18);
+    CHECK(h[2].kind == atomic::op::fence);
+    CHECK(h[2].order == std::memory_order_release);
+    CHECK(h[2].value_size == 0);
+}
+
+TEST_CASE("recording policy records each thread separately",
+          "[atomic_recording_policy]") {
+    atomic::recorder::reset();
+    std::uint32_t val{};
+    auto const f = [&] {
+        for (auto i = 0; i < 100; ++i) {
+            atomic::fetch_add(val, 1);
+        }
+    };
+    auto t1 = std::thread{f};
+    auto t2 = std::thread{f};
+    t1.join();
+    t2.join();
+
+    auto const h = atomic::recorder::collect();
+    REQUIRE(h.size() == 200);
+    auto threads = std::set<std::size_t>{};
+    for (auto const &e : h) {
+        threads.insert(e.thread);
+    }
+    CHECK(threads.size() == 2);
+    CHECK(atomic::recorder::dropped() == 0);
+    CHECK(atomic::check(h).empty());
+}
+
+TEST_CASE("events of exited threads are kept until reset",
+          "[atomic_recording_policy]") {
+    atomic::recorder::reset();
+    std::uint32_t val{};
+    std::thread{[&] { atomic::store(val, 1u); }}.join();
+    std::thread{[] {}}.join();
+    CHECK(atomic::recorder::collect().size() == 1);
+
+    atomic::recorder::reset();
+    CHECK(atomic::recorder::collect().empty());
+    std::thread{[&] { atomic::store(val, 2u); }}.join();
+    auto const h = atomic::recorder::collect();
+    REQUIRE(h.size() == 1);
+    CHECK(h[0].written == 2);
+}
+
+namespace {
+auto make_event(std::uint64_t begin, std::uint64_t end, atomic::op kind,
+                std::uint64_t read, std::uint64_t written,
+                std::size_t thread = 0,
+                std::memory_order mo = std::memory_order_seq_cst)
+    -> atomic::event {
+    static int location{};
+    return {.begin = begin,
+            .end = end,
+            .address = &location,
+            .read = read,
+            .written = written,
+            .thread = thread,
+            .kind = kind,
+            .order = mo,
+            .value_size = sizeof(int)};
+}
+
+auto only_violation(std::vector<atomic::event> const &h,
+                    atomic::check_options const &options = {})
+    -> std::optional<atomic::violation::kind> {
+    auto const v = atomic::check(h, options);
+    if (v.size() != 1) {
+        return {};
+    }
+    return v[0].what;
+}
+} // namespace
+
+TEST_CASE("check detects an unwritten value", "[atomic_recording_policy]") {
+    auto const h = std::vector{
+        make_event(0, 1, atomic::op::load, 0, 0),
+        make_event(2, 3, atomic::op::store, 0, 1),
+        make_event(4, 5, atomic::op::load, 42, 0, 1),
+    };
+    CHECK(only_violation(h, {.linearizability_limit = 0}) ==
+          atomic::violation::kind::unwritten_value);
+}
+
+TEST_CASE("check detects a coherence violation", "[atomic_recording_policy]") {
+    auto const h = std::vector{
+        make_event(0, 1, atomic::op::store, 0, 1, 0, std::memory_order_relaxed),
+        make_event(2, 3, atomic::op::store, 0, 2, 0, std::memory_order_relaxed),
+        make_event(4, 5, atomic::op::load, 1, 0, 0, std::memory_order_relaxed),
+    };
+    CHECK(only_violation(h) == atomic::violation::kind::coherence);
+}
+
+TEST_CASE("check detects a missing release", "[atomic_recording_policy]") {
+    auto const h = std::vector{
+        make_event(0, 1, atomic::op::store, 0, 1, 0, std::memory_order_relaxed),
+        make_event(2, 3, atomic::op::load, 1, 0, 1, std::memory_order_acquire),
+    };
+    CHECK(only_violation(h, {.missing_release = true}) ==
+          atomic::violation::kind::missing_release);
+}
+
+TEST_CASE("a missing release is not reported by default",
+          "[atomic_recording_policy]") {
+    // a relaxed counter, read with acquire
+    auto const h = std::vector{
+        make_event(0, 1, atomic::op::fetch_add, 0, 1, 0,
+                   std::memory_order_relaxed),
+        make_event(2, 3, atomic::op::fetch_add, 1, 2, 1,
+                   std::memory_order_relaxed),
+        make_event(4, 5, atomic::op::load, 2, 0, 2, std::memory_order_acquire),
+    };
+    CHECK(atomic::check(h).empty());
+    CHECK(only_violation(h, {.missing_release = true}) ==
+          atomic::violation::kind::missing_release);
+}
+
+TEST_CASE("a release fence makes a relaxed write a release",
+          "[atomic_recording_policy]") {
+    auto fence = make_event(0, 1, atomic::op::fence, 0, 0, 0,
+                            std::memory_order_release);
+    fence.address = nullptr;
+    fence.value_size = 0;
+    auto const h = std::vector{
+        fence,
+        make_event(2, 3, atomic::op::store, 0, 1, 0, std::memory_order_relaxed),
+        make_event(4, 5, atomic::op::load, 1, 0, 1, std::memory_order_acquire),
+    };
+    CHECK(atomic::check(h, {.missing_release = true}).empty());
+}
+
+TEST_CASE("a relaxed read-modify-write continues a release sequence",
+          "[atomic_recording_policy]") {
+    auto const h = std::vector{
+        make_event(0, 1, atomic::op::store, 0, 1, 0, std::memory_order_release),
+        make_event(2, 3, atomic::op::fetch_add, 1, 2, 1,
+                   std::memory_order_relaxed),
+        make_event(4, 5, atomic::op::fetch_add, 2, 3, 2,
+                   std::memory_order_relaxed),
+        make_event(6, 7, atomic::op::load, 3, 0, 3, std::memory_order_acquire),
+    };
+    CHECK(atomic::check(h, {.missing_release = true}).empty());
+}
+
+TEST_CASE("a release sequence needs a release at its head",
+          "[atomic_recording_policy]") {
+    auto const h = std::vector{
+        make_event(0, 1, atomic::op::store, 0, 1, 0, std::memory_order_relaxed),
+        make_event(2, 3, atomic::op::fetch_add, 1, 2, 1,
+                   std::memory_order_relaxed),
+        make_event(4, 5, atomic::op::load, 2, 0, 2, std::memory_order_acquire),
+    };
+    CHECK(only_violation(h, {.missing_release = true}) ==
+          atomic::violation::kind::missing_release);
+}
+
+TEST_CASE("check detects a non-linearizable history",
+          "[atomic_recording_policy]") {
+    // both reads follow the write of 2 in real time, but disagree
+    auto const h = std::vector{
+        make_event(0, 1, atomic::op::store, 0, 1),
+        make_event(2, 3, atomic::op::store, 0, 2, 1),
+        make_event(4, 5, atomic::op::load, 1, 0, 2),
+    };
+    CHECK(only_violation(h) == atomic::violation::kind::not_linearizable);
+}
+
+TEST_CASE("overlapping operations may linearize in either order",
+          "[atomic_recording_policy]") {
+    auto const h = std::vector{
+        make_event(0, 1, atomic::op::store, 0, 1),
+        make_event(2, 6, atomic::op::store, 0, 2, 1),
+        make_event(3, 5, atomic::op::load, 1, 0, 2),
+        make_event(4, 7, atomic::op::load, 2, 0, 3),
+    };
+    CHECK(atomic::check(h).empty());
+}
+
+namespace {
+struct stack_op {
+    std::uint64_t begin{};
+    std::uint64_t end{};
+    bool push{};
+    int value{};
+};
+
+struct stack_spec {
+    using state_type = std::vector<int>;
+    [[nodiscard]] static auto initial() -> state_type { return {}; }
+    static auto apply(state_type &s, stack_op const &op) -> bool {
+        if (op.push) {
+            s.push_back(op.value);
+            return true;
+        }
+        if (s.empty() or s.back() != op.value) {
+            return false;
+        }
+        s.pop_back();
+        return true;
+    }
+};
+} // namespace
+
+TEST_CASE("user histories are checked against a sequential spec",
+          "[atomic_recording_policy]") {
+    auto const good = std::array{
+        stack_op{0, 2, true, 1},
+        stack_op{1, 3, true, 2},
+        stack_op{4, 5, false, 1},
+        stack_op{6, 7, false, 2},
+    };
+    CHECK(atomic::is_linearizable<stack_spec>(good));
+
+    auto const bad = std::array{
+        stack_op{0, 1, true, 1},
+        stack_op{2, 3, true, 2},
+        stack_op{4, 5, false, 1},
+    };
+    CHECK(not atomic::is_linearizable<stack_spec>(bad));
+}
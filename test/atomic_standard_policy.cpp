@@ -14,6 +14,9 @@ TEST_CASE("standard policy models concepts", "[atomic_standard_policy]") {
     STATIC_REQUIRE(atomic::add_sub_policy<atomic::detail::standard_policy>);
     STATIC_REQUIRE(atomic::bitwise_policy<atomic::detail::standard_policy>);
     STATIC_REQUIRE(atomic::policy<atomic::detail::standard_policy>);
+    STATIC_REQUIRE(
+        atomic::compare_exchange_policy<atomic::detail::standard_policy>);
+    STATIC_REQUIRE(atomic::fence_policy<atomic::detail::standard_policy>);
 }
 #endif
 
@@ -160,6 +163,69 @@ TEST_CASE("standard policy implements fetch_xor atomically",
     CHECK(val == 0b100);
 }
 
+TEST_CASE("standard policy implements compare_exchange_strong",
+          "[atomic_standard_policy]") {
+    std::uint32_t val{17};
+    std::uint32_t expected{17};
+    CHECK(atomic::compare_exchange_strong(val, expected, 1337));
+    CHECK(val == 1337);
+    CHECK(not atomic::compare_exchange_strong(val, expected, 42));
+    CHECK(expected == 1337);
+    CHECK(val == 1337);
+}
+
+TEST_CASE("standard policy implements compare_exchange_weak",
+          "[atomic_standard_policy]") {
+    std::uint32_t val{17};
+    std::uint32_t expected{17};
+    while (not atomic::compare_exchange_weak(val, expected, 1337,
+                                             std::memory_order_acq_rel)) {
+        CHECK(expected == 17);
+    }
+    CHECK(val == 1337);
+    CHECK(not atomic::compare_exchange_weak(val, expected, 42,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed));
+    CHECK(expected == 1337);
+}
+
+TEST_CASE("standard policy implements compare_exchange atomically",
+          "[atomic_standard_policy]") {
+    std::uint32_t val{};
+    auto const increment = [&] {
+        for (auto i = 0; i < 1000; ++i) {
+            auto expected = atomic::load(val, std::memory_order_relaxed);
+            while (not atomic::compare_exchange_weak(val, expected,
+                                                     expected + 1)) {
+            }
+        }
+    };
+    auto t1 = std::thread{increment};
+    auto t2 = std::thread{increment};
+    t1.join();
+    t2.join();
+    CHECK(val == 2000);
+}
+
+TEST_CASE("standard policy implements thread_fence",
+          "[atomic_standard_policy]") {
+    std::uint32_t data{};
+    std::uint32_t flag{};
+    auto t1 = std::thread([&] {
+        data = 17;
+        atomic::thread_fence(std::memory_order_release);
+        atomic::store(flag, 1, std::memory_order_relaxed);
+    });
+    auto t2 = std::thread([&] {
+        while (atomic::load(flag, std::memory_order_relaxed) == 0) {
+        }
+        atomic::thread_fence(std::memory_order_acquire);
+        CHECK(data == 17);
+    });
+    t1.join();
+    t2.join();
+}
+
 TEMPLATE_TEST_CASE("standard policy has normal types",
                    "[atomic_standard_policy]", bool, std::uint8_t,
                    std::uint16_t, std::uint32_t, std::uint64_t) {
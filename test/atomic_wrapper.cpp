@@ -0,0 +1,128 @@
+#include <conc/atomic.hpp>
+#include <conc/atomic_wrapper.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace {
+enum struct state : std::uint8_t { idle, busy };
+
+template <typename T>
+concept has_fetch_add = requires(T &t) { t.fetch_add({}); };
+} // namespace
+
+TEST_CASE("atomic applies the configured storage type", "[atomic_wrapper]") {
+    STATIC_REQUIRE(
+        std::is_same_v<atomic::atomic<bool>::storage_type, std::uint32_t>);
+    STATIC_REQUIRE(sizeof(atomic::atomic<bool>) == sizeof(std::uint32_t));
+    STATIC_REQUIRE(std::is_same_v<atomic::atomic<bool>::value_type, bool>);
+}
+
+TEST_CASE("atomic applies the configured alignment", "[atomic_wrapper]") {
+    STATIC_REQUIRE(alignof(atomic::atomic<std::uint8_t>) == 4);
+    STATIC_REQUIRE(alignof(atomic::atomic<std::uint64_t>) ==
+                   atomic::alignment_of<std::uint64_t>);
+}
+
+TEST_CASE("a padded atomic occupies a cache line", "[atomic_wrapper]") {
+    STATIC_REQUIRE(alignof(atomic::padded_atomic<std::uint32_t>) ==
+                   atomic::cache_line_size<>);
+    STATIC_REQUIRE(sizeof(atomic::padded_atomic<std::uint32_t>) ==
+                   atomic::cache_line_size<>);
+}
+
+TEST_CASE("atomic is constexpr constructible", "[atomic_wrapper]") {
+    constinit static atomic::atomic<std::uint32_t> a{17};
+    CHECK(a.load() == 17);
+}
+
+TEST_CASE("atomic load and store", "[atomic_wrapper]") {
+    atomic::atomic<bool> b{};
+    CHECK(not b.load());
+    b.store(true, std::memory_order_release);
+    CHECK(b.load(std::memory_order_acquire));
+    b = false;
+    CHECK(not b);
+}
+
+TEST_CASE("atomic exchange", "[atomic_wrapper]") {
+    atomic::atomic<state> s{state::idle};
+    CHECK(s.exchange(state::busy) == state::idle);
+    CHECK(s.load() == state::busy);
+}
+
+TEST_CASE("atomic compare-exchange", "[atomic_wrapper]") {
+    atomic::atomic<bool> b{};
+    auto expected = true;
+    CHECK(not b.compare_exchange_strong(expected, true));
+    CHECK(not expected);
+    CHECK(b.compare_exchange_strong(expected, true, std::memory_order_acq_rel));
+    CHECK(b.load());
+
+    atomic::atomic<std::uint32_t> a{17};
+    auto e = 17u;
+    while (not a.compare_exchange_weak(e, 42u, std::memory_order_acq_rel,
+                                       std::memory_order_relaxed)) {
+    }
+    CHECK(a.load() == 42);
+}
+
+TEST_CASE("atomic arithmetic", "[atomic_wrapper]") {
+    atomic::padded_atomic<std::uint32_t> a{17};
+    CHECK(a.fetch_add(3) == 17);
+    CHECK(a.fetch_sub(1) == 20);
+    CHECK(++a == 20);
+    CHECK(a++ == 20);
+    CHECK(--a == 20);
+    CHECK(a-- == 20);
+    CHECK((a += 5) == 24);
+    CHECK((a -= 4) == 20);
+    CHECK((a &= 0x1c) == 0x14);
+    CHECK((a |= 0x1) == 0x15);
+    CHECK((a ^= 0x4) == 0x11);
+    CHECK(a.fetch_and(0x1) == 0x11);
+    CHECK(a.fetch_or(0x2) == 0x1);
+    CHECK(a.fetch_xor(0x3) == 0x3);
+    CHECK(a.load() == 0);
+}
+
+TEST_CASE("signed arithmetic wraps", "[atomic_wrapper]") {
+    constexpr auto max = std::numeric_limits<int>::max();
+    constexpr auto min = std::numeric_limits<int>::min();
+    atomic::atomic<int> a{max};
+    CHECK(++a == min);
+    CHECK(--a == max);
+    CHECK((a += 2) == min + 1);
+    CHECK((a -= 2) == max);
+    CHECK(a.load() == max);
+}
+
+TEST_CASE("pointer arithmetic is scaled by the pointee size",
+          "[atomic_wrapper]") {
+    std::array<std::uint64_t, 8> arr{};
+    atomic::atomic<std::uint64_t *> a{arr.data()};
+    CHECK(a.fetch_add(3) == arr.data());
+    CHECK(a.fetch_sub(1) == arr.data() + 3);
+    CHECK(++a == arr.data() + 3);
+    CHECK(a++ == arr.data() + 3);
+    CHECK(--a == arr.data() + 3);
+    CHECK(a-- == arr.data() + 3);
+    CHECK((a += 5) == arr.data() + 7);
+    CHECK((a -= 4) == arr.data() + 3);
+    CHECK(a.load() == arr.data() + 3);
+}
+
+TEST_CASE("arithmetic is only available for integral and object pointer "
+          "types",
+          "[atomic_wrapper]") {
+    STATIC_REQUIRE(has_fetch_add<atomic::atomic<std::uint32_t>>);
+    STATIC_REQUIRE(not has_fetch_add<atomic::atomic<bool>>);
+    STATIC_REQUIRE(not has_fetch_add<atomic::atomic<state>>);
+    STATIC_REQUIRE(has_fetch_add<atomic::atomic<std::uint32_t *>>);
+    STATIC_REQUIRE(not has_fetch_add<atomic::atomic<void *>>);
+}
@@ -0,0 +1,120 @@
+#include <conc/atomic.hpp>
+#include <conc/barrier.hpp>
+#include <conc/concepts.hpp>
+#include <conc/parking_lot.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+// a user-provided strategy, declared exactly as the concept requires
+struct yield_wait {
+    static auto wait(std::uint32_t const &w, std::uint32_t old) -> void {
+        while (atomic::load(w, std::memory_order_acquire) == old) {
+            std::this_thread::yield();
+        }
+    }
+    static auto notify_all(std::uint32_t &) -> void {}
+};
+
+// waits through a non-const reference, so it cannot wait on a const word
+struct mutable_wait {
+    static auto wait(std::uint32_t &, std::uint32_t) -> void {}
+    static auto notify_all(std::uint32_t &) -> void {}
+};
+} // namespace
+
+TEST_CASE("spinning and parking are wait strategies", "[barrier]") {
+    STATIC_REQUIRE(conc::wait_strategy<conc::spin_wait>);
+    STATIC_REQUIRE(conc::wait_strategy<conc::parking_wait>);
+    STATIC_REQUIRE(conc::wait_strategy<yield_wait>);
+    STATIC_REQUIRE(not conc::wait_strategy<mutable_wait>);
+}
+
+TEST_CASE("a latch opens when its count reaches zero", "[barrier]") {
+    conc::latch l{2};
+    CHECK(not l.try_wait());
+    l.count_down();
+    CHECK(not l.try_wait());
+    l.count_down();
+    CHECK(l.try_wait());
+    l.wait();
+}
+
+TEMPLATE_TEST_CASE("a latch releases waiting threads", "[barrier]",
+                   conc::spin_wait, conc::parking_wait, yield_wait) {
+    constexpr auto threads = 4u;
+    conc::latch<TestType> l{threads};
+    std::uint32_t done{};
+
+    std::vector<std::thread> ts{};
+    for (auto i = 0u; i < threads; ++i) {
+        ts.emplace_back([&] {
+            l.arrive_and_wait();
+            atomic::fetch_add(done, 1u);
+        });
+    }
+    for (auto &t : ts) {
+        t.join();
+    }
+    CHECK(done == threads);
+    CHECK(l.try_wait());
+}
+
+namespace {
+// Each thread writes its slot, waits at the barrier, then checks that every
+// other thread's slot was written in the same phase.
+template <std::size_t Threads, typename Arrive>
+auto check_phases(Arrive &&arrive) -> bool {
+    constexpr auto phases = 50u;
+    std::array<std::uint32_t, Threads> slots{};
+    std::uint32_t mismatches{};
+
+    std::vector<std::thread> ts{};
+    for (auto i = std::size_t{}; i < Threads; ++i) {
+        ts.emplace_back([&, i] {
+            for (auto p = 1u; p <= phases; ++p) {
+                atomic::store(slots[i], p, std::memory_order_relaxed);
+                arrive(i);
+                for (auto const &s : slots) {
+                    auto const v = atomic::load(s, std::memory_order_relaxed);
+                    if (v != p) {
+                        atomic::fetch_add(mismatches, 1u);
+                    }
+                }
+                arrive(i);
+            }
+        });
+    }
+    for (auto &t : ts) {
+        t.join();
+    }
+    return mismatches == 0;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("a barrier separates phases", "[barrier]", conc::spin_wait,
+                   conc::parking_wait, yield_wait) {
+    constexpr auto threads = std::size_t{5};
+    conc::barrier<TestType> b{threads};
+    CHECK(check_phases<threads>([&](std::size_t) { b.arrive_and_wait(); }));
+}
+
+TEMPLATE_TEST_CASE("a tree barrier separates phases", "[barrier]",
+                   conc::spin_wait, conc::parking_wait, yield_wait) {
+    constexpr auto threads = std::size_t{7};
+    conc::tree_barrier<threads, TestType, 2> b{};
+    CHECK(check_phases<threads>([&](std::size_t i) { b.arrive_and_wait(i); }));
+}
+
+TEST_CASE("a tree barrier works for one thread", "[barrier]") {
+    conc::tree_barrier<1> b{};
+    b.arrive_and_wait(0);
+    b.arrive_and_wait(0);
+}
@@ -0,0 +1,69 @@
+#include "benchmark.hpp"
+
+#include <conc/barrier.hpp>
+#include <conc/parking_lot.hpp>
+
+#include <barrier>
+#include <bit>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+constexpr auto phases = std::size_t{2'000};
+constexpr auto max_threads = std::size_t{64};
+
+// the time per phase of threads threads crossing a barrier in lockstep
+template <typename Arrive>
+auto ns_per_phase(unsigned threads, Arrive &&arrive) -> double {
+    return bench::ns_per_op_on(threads, phases, arrive) * threads;
+}
+
+template <typename Arrive>
+auto report(std::string const &name, unsigned threads, bool spins,
+            Arrive &&arrive) -> void {
+    auto const label = name + ", " + std::to_string(threads) + " threads";
+    // a spinning waiter only gives up its CPU when preempted
+    if (spins and std::thread::hardware_concurrency() < threads) {
+        std::printf("%s: skipped (fewer CPUs than threads)\n", label.c_str());
+        return;
+    }
+    bench::report(label, ns_per_phase(threads, arrive));
+}
+
+template <std::size_t Threads> auto report_all() -> void {
+    constexpr auto threads = static_cast<unsigned>(Threads);
+
+    conc::barrier<conc::spin_wait> spin{threads};
+    report("barrier<spin_wait>", threads, true,
+           [&](unsigned) { spin.arrive_and_wait(); });
+
+    conc::tree_barrier<Threads, conc::spin_wait> tree{};
+    report("tree_barrier<spin_wait>", threads, true,
+           [&](unsigned t) { tree.arrive_and_wait(t); });
+
+    conc::barrier<conc::parking_wait> parking{threads};
+    report("barrier<parking_wait>", threads, false,
+           [&](unsigned) { parking.arrive_and_wait(); });
+
+    conc::tree_barrier<Threads, conc::parking_wait> parking_tree{};
+    report("tree_barrier<parking_wait>", threads, false,
+           [&](unsigned t) { parking_tree.arrive_and_wait(t); });
+
+    std::barrier standard{static_cast<std::ptrdiff_t>(threads)};
+    report("std::barrier", threads, false,
+           [&](unsigned) { standard.arrive_and_wait(); });
+}
+
+// 2, 4, 8, ... max_threads
+template <std::size_t... Is>
+auto report_sweep(std::index_sequence<Is...>) -> void {
+    (report_all<std::size_t{2} << Is>(), ...);
+}
+} // namespace
+
+auto main() -> int {
+    report_sweep(std::make_index_sequence<std::countr_zero(max_threads)>{});
+}
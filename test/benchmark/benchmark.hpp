@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <latch>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace bench {
+// keep the compiler from optimizing away the computation of t
+template <typename T> auto do_not_optimize(T const &t) -> void {
+    asm volatile("" : : "r,m"(t) : "memory");
+}
+
+// the mean time of a call to f(), over n calls
+template <typename F> auto ns_per_op(std::size_t n, F &&f) -> double {
+    auto const start = std::chrono::steady_clock::now();
+    for (auto i = std::size_t{}; i < n; ++i) {
+        f();
+    }
+    std::chrono::duration<double, std::nano> const elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(n);
+}
+
+// the wall-clock time per call when each of threads threads, started
+// together, calls f(thread_index) n times
+template <typename F>
+auto ns_per_op_on(unsigned threads, std::size_t n, F &&f) -> double {
+    using clock = std::chrono::steady_clock;
+    std::latch ready{threads};
+    std::vector<clock::time_point> starts(threads);
+    std::vector<clock::time_point> ends(threads);
+    {
+        std::vector<std::jthread> ts{};
+        for (auto t = 0u; t < threads; ++t) {
+            ts.emplace_back([&, t] {
+                ready.arrive_and_wait();
+                starts[t] = clock::now();
+                for (auto i = std::size_t{}; i < n; ++i) {
+                    f(t);
+                }
+                ends[t] = clock::now();
+            });
+        }
+    }
+    std::chrono::duration<double, std::nano> const elapsed =
+        *std::max_element(ends.begin(), ends.end()) -
+        *std::min_element(starts.begin(), starts.end());
+    return elapsed.count() / static_cast<double>(n * threads);
+}
+
+inline auto report(std::string_view name, double ns) -> void {
+    std::printf("%-56.*s %10.1f ns/op\n", static_cast<int>(name.size()),
+                name.data(), ns);
+}
+} // namespace bench
@@ -0,0 +1,118 @@
+#include "benchmark.hpp"
+
+#include <conc/pi_mutex.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Priority inversion: a low-priority thread holds a lock that a high-priority
+// thread needs, and a medium-priority thread preempts the holder. All three
+// are SCHED_FIFO threads on one CPU, so with std::mutex the high-priority
+// thread waits for the medium-priority thread's work as well; with pi_mutex
+// the holder inherits the waiter's priority, and the wait is bounded by the
+// critical section.
+namespace {
+using namespace std::chrono_literals;
+
+constexpr auto samples = std::size_t{200};
+constexpr auto section = 50us;
+constexpr auto medium_work = 500us;
+
+auto spin_for(std::chrono::microseconds d) -> void {
+    auto const end = std::chrono::steady_clock::now() + d;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// make the calling thread a SCHED_FIFO thread on CPU 0
+auto make_realtime(int priority) -> bool {
+    cpu_set_t cpus{};
+    CPU_ZERO(&cpus);
+    CPU_SET(0, &cpus);
+    sched_param const param{.sched_priority = priority};
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0 and
+           pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+// the times the high-priority thread waited for the lock, or nothing if
+// real-time threads are not permitted
+template <typename Mutex>
+auto inversion_waits() -> std::vector<std::chrono::nanoseconds> {
+    Mutex m{};
+    std::atomic<bool> stop{};
+    std::atomic<bool> permitted{true};
+    std::vector<std::chrono::nanoseconds> waits{};
+    std::thread low{[&] {
+        if (not make_realtime(1)) {
+            permitted = false;
+        }
+        while (permitted and not stop) {
+            {
+                std::lock_guard l{m};
+                spin_for(section);
+            }
+            std::this_thread::sleep_for(100us);
+        }
+    }};
+    std::thread medium{[&] {
+        if (not make_realtime(5)) {
+            permitted = false;
+        }
+        while (permitted and not stop) {
+            std::this_thread::sleep_for(1ms);
+            spin_for(medium_work);
+        }
+    }};
+    std::thread high{[&] {
+        if (not make_realtime(10)) {
+            permitted = false;
+        }
+        for (auto i = std::size_t{}; permitted and i < samples; ++i) {
+            std::this_thread::sleep_for(1ms);
+            auto const start = std::chrono::steady_clock::now();
+            std::lock_guard l{m};
+            waits.push_back(std::chrono::steady_clock::now() - start);
+        }
+        stop = true;
+    }};
+    high.join();
+    medium.join();
+    low.join();
+    if (not permitted) {
+        waits.clear();
+    }
+    return waits;
+}
+
+template <typename Mutex> auto report(std::string_view name) -> void {
+    auto waits = inversion_waits<Mutex>();
+    if (waits.empty()) {
+        std::printf("%.*s: skipped (SCHED_FIFO threads not permitted)\n",
+                    static_cast<int>(name.size()), name.data());
+        return;
+    }
+    std::sort(waits.begin(), waits.end());
+    auto const us = [&](std::size_t percentile) {
+        auto const i = (waits.size() - 1) * percentile / 100;
+        return std::chrono::duration<double, std::micro>{waits[i]}.count();
+    };
+    std::printf("%-40.*s p50 %8.1f us  p99 %8.1f us  max %8.1f us\n",
+                static_cast<int>(name.size()), name.data(), us(50), us(99),
+                us(100));
+}
+} // namespace
+
+auto main() -> int {
+    report<std::mutex>("std::mutex wait under inversion");
+    report<conc::pi_mutex>("pi_mutex wait under inversion");
+}
@@ -0,0 +1,54 @@
+#include "benchmark.hpp"
+
+#include <conc/reader_biased.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+
+namespace {
+constexpr auto iterations = std::size_t{1'000'000};
+constexpr auto threads = 4u;
+
+using policy = conc::reader_biased_policy<>;
+struct data_tag;
+
+std::uint64_t data{};
+std::shared_mutex shared_m{};
+
+auto biased_read() -> void {
+    bench::do_not_optimize(
+        policy::call_in_read_section<data_tag>([] { return data; }));
+}
+auto shared_mutex_read() -> void {
+    std::shared_lock l{shared_m};
+    bench::do_not_optimize(data);
+}
+
+auto biased_write() -> void {
+    policy::call_in_critical_section<data_tag>([] { ++data; });
+}
+auto shared_mutex_write() -> void {
+    std::lock_guard l{shared_m};
+    ++data;
+}
+} // namespace
+
+auto main() -> int {
+    bench::report("reader_biased_policy read",
+                  bench::ns_per_op(iterations, biased_read));
+    bench::report("std::shared_mutex read",
+                  bench::ns_per_op(iterations, shared_mutex_read));
+    bench::report("reader_biased_policy read, 4 threads",
+                  bench::ns_per_op_on(threads, iterations / threads,
+                                      [](unsigned) { biased_read(); }));
+    bench::report("std::shared_mutex read, 4 threads",
+                  bench::ns_per_op_on(threads, iterations / threads,
+                                      [](unsigned) { shared_mutex_read(); }));
+    // a write waits for every reader slot, so it costs more than a lock
+    bench::report("reader_biased_policy write",
+                  bench::ns_per_op(iterations / 100, biased_write));
+    bench::report("std::shared_mutex write",
+                  bench::ns_per_op(iterations / 100, shared_mutex_write));
+}
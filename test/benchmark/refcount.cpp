@@ -0,0 +1,59 @@
+#include "benchmark.hpp"
+
+#include <conc/biased_refcount.hpp>
+#include <conc/refcount.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace {
+constexpr auto iterations = std::size_t{1'000'000};
+constexpr auto threads = 4u;
+
+struct plain {
+    int value{};
+};
+struct counted : conc::refcount {
+    int value{};
+};
+struct biased : conc::biased_refcount<biased> {
+    int value{};
+};
+
+// take a reference and drop it again
+template <typename Ptr> auto copy_drop(Ptr const &p) -> void {
+    auto copy = p;
+    bench::do_not_optimize(copy);
+}
+
+template <typename Ptr> auto same_thread(Ptr const &p) -> double {
+    return bench::ns_per_op(iterations, [&] { copy_drop(p); });
+}
+
+template <typename Ptr> auto other_threads(Ptr const &p) -> double {
+    return bench::ns_per_op_on(threads, iterations / threads,
+                               [&](unsigned) { copy_drop(p); });
+}
+} // namespace
+
+auto main() -> int {
+    // std::shared_ptr skips atomic operations until the process has started
+    // a thread; measure it as a threaded program would see it
+    std::thread{[] {}}.join();
+
+    auto const shared = std::make_shared<plain>();
+    auto const intrusive = conc::make_intrusive<counted>();
+    auto const owned = conc::make_intrusive<biased>();
+
+    bench::report("std::shared_ptr copy", same_thread(shared));
+    bench::report("intrusive_ptr<refcount> copy", same_thread(intrusive));
+    bench::report("intrusive_ptr<biased_refcount> copy, owner",
+                  same_thread(owned));
+
+    bench::report("std::shared_ptr copy, 4 threads", other_threads(shared));
+    bench::report("intrusive_ptr<refcount> copy, 4 threads",
+                  other_threads(intrusive));
+    bench::report("intrusive_ptr<biased_refcount> copy, 4 other threads",
+                  other_threads(owned));
+}
@@ -0,0 +1,130 @@
+#include "benchmark.hpp"
+
+#include <conc/concurrency.hpp>
+#include <conc/work_stealing_deque.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <optional>
+#include <string_view>
+#include <thread>
+
+namespace {
+constexpr auto iterations = std::size_t{1'000'000};
+constexpr auto batch = std::uint32_t{64};
+constexpr auto duration = std::chrono::milliseconds{200};
+
+// a deque guarded by critical sections (under the standard policy, a mutex),
+// as the work queue of a scheduler without stealing support is
+class locked_deque {
+    struct queue_CS;
+    std::deque<std::uint32_t> d{};
+
+  public:
+    auto push(std::uint32_t t) -> void {
+        conc::call_in_critical_section<queue_CS>([&] { d.push_back(t); });
+    }
+    auto take() -> std::optional<std::uint32_t> {
+        return conc::call_in_critical_section<queue_CS>(
+            [&]() -> std::optional<std::uint32_t> {
+                if (d.empty()) {
+                    return std::nullopt;
+                }
+                auto const t = d.back();
+                d.pop_back();
+                return t;
+            });
+    }
+    auto steal() -> std::optional<std::uint32_t> {
+        return conc::call_in_critical_section<queue_CS>(
+            [&]() -> std::optional<std::uint32_t> {
+                if (d.empty()) {
+                    return std::nullopt;
+                }
+                auto const t = d.front();
+                d.pop_front();
+                return t;
+            });
+    }
+};
+
+// the owner pushes a batch of tasks, then takes back those not stolen;
+// returns the number of successful operations
+template <typename Deque> auto push_take(Deque &d) -> std::size_t {
+    for (auto i = std::uint32_t{}; i < batch; ++i) {
+        d.push(i);
+    }
+    auto taken = std::size_t{};
+    while (auto t = d.take()) {
+        bench::do_not_optimize(*t);
+        ++taken;
+    }
+    return batch + taken;
+}
+
+template <typename Deque> auto uncontended() -> double {
+    Deque d{};
+    return bench::ns_per_op(iterations / batch, [&] { push_take(d); }) /
+           (2 * batch);
+}
+
+struct rates {
+    double owner_ops{};
+    double steals{};
+};
+
+// the owner's successful pushes and takes, and another thread's successful
+// steals, per second, while both run. On a single CPU, the thief can only
+// steal while the owner is preempted.
+template <typename Deque> auto with_thief() -> rates {
+    Deque d{};
+    std::atomic<bool> started{};
+    std::atomic<bool> stop{};
+    std::atomic<std::size_t> steals{};
+    std::jthread thief{[&] {
+        started = true;
+        auto n = std::size_t{};
+        while (not stop.load(std::memory_order_relaxed)) {
+            if (d.steal()) {
+                ++n;
+            }
+        }
+        steals = n;
+    }};
+
+    while (not started) {
+        std::this_thread::yield();
+    }
+
+    // long enough for the threads to share a CPU, if they must
+    auto owner_ops = std::size_t{};
+    auto const start = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration<double>{};
+    while (elapsed < duration) {
+        owner_ops += push_take(d);
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+    stop = true;
+    thief.join();
+    return {static_cast<double>(owner_ops) / elapsed.count(),
+            static_cast<double>(steals.load()) / elapsed.count()};
+}
+
+auto report(std::string_view name, rates r) -> void {
+    std::printf("%-36.*s owner %12.0f ops/s  thief %12.0f steals/s\n",
+                static_cast<int>(name.size()), name.data(), r.owner_ops,
+                r.steals);
+}
+} // namespace
+
+auto main() -> int {
+    using wsd = conc::work_stealing_deque<std::uint32_t>;
+    bench::report("work_stealing_deque push/take", uncontended<wsd>());
+    bench::report("locked std::deque push/take", uncontended<locked_deque>());
+    report("work_stealing_deque, one thief", with_thief<wsd>());
+    report("locked std::deque, one thief", with_thief<locked_deque>());
+}
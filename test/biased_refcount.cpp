@@ -0,0 +1,107 @@
+#include <conc/biased_refcount.hpp>
+#include <conc/refcount.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+std::atomic<int> destroyed{};
+
+struct object : conc::biased_refcount<object> {
+    object() = default;
+    object(object const &) = delete;
+    object(object &&) = delete;
+    auto operator=(object const &) -> object & = delete;
+    auto operator=(object &&) -> object & = delete;
+    ~object() { ++destroyed; }
+};
+} // namespace
+
+TEST_CASE("biased_refcount models refcounted", "[biased_refcount]") {
+    STATIC_REQUIRE(conc::refcounted<object>);
+}
+
+TEST_CASE("the owner counts references", "[biased_refcount]") {
+    destroyed = 0;
+    {
+        auto p = conc::make_intrusive<object>();
+        auto q = p;
+        auto r = q;
+        q.reset();
+        CHECK(destroyed == 0);
+    }
+    CHECK(destroyed == 1);
+}
+
+TEST_CASE("another thread can drop the last reference", "[biased_refcount]") {
+    destroyed = 0;
+    auto p = conc::make_intrusive<object>();
+    auto q = p;
+    p.reset();
+    std::thread{[q = std::move(q)]() mutable { q.reset(); }}.join();
+    // the reference dropped was counted by the owner
+    CHECK(destroyed == 0);
+    conc::collect_biased_refcounts();
+    CHECK(destroyed == 1);
+}
+
+TEST_CASE("the owner can drop the last reference after other threads",
+          "[biased_refcount]") {
+    destroyed = 0;
+    auto p = conc::make_intrusive<object>();
+    std::thread{[q = p]() mutable {
+        auto r = q;
+        q.reset();
+        r.reset();
+    }}.join();
+    CHECK(destroyed == 0);
+    p.reset();
+    CHECK(destroyed == 1);
+}
+
+TEST_CASE("objects of an exited owner are reclaimed", "[biased_refcount]") {
+    destroyed = 0;
+    conc::intrusive_ptr<object> p{};
+    std::thread{[&] {
+        p = conc::make_intrusive<object>();
+        auto q = p;
+    }}.join();
+    CHECK(destroyed == 0);
+    p.reset();
+    CHECK(destroyed == 1);
+}
+
+TEST_CASE("references can be shared between threads", "[biased_refcount]") {
+    constexpr auto threads = 4u;
+    constexpr auto objects = 100u;
+    constexpr auto copies = 100u;
+    destroyed = 0;
+
+    std::vector<conc::intrusive_ptr<object>> ps{};
+    for (auto i = 0u; i < objects; ++i) {
+        ps.push_back(conc::make_intrusive<object>());
+    }
+    std::array<std::thread, threads> ts{};
+    for (auto &t : ts) {
+        t = std::thread{[ps] {
+            for (auto const &p : ps) {
+                for (auto i = 0u; i < copies; ++i) {
+                    [[maybe_unused]] auto q = p;
+                }
+            }
+        }};
+    }
+    for (auto &t : ts) {
+        t.join();
+    }
+    conc::collect_biased_refcounts();
+    CHECK(destroyed == 0);
+    ps.clear();
+    conc::collect_biased_refcounts();
+    CHECK(destroyed == objects);
+}
@@ -0,0 +1,41 @@
+#include <conc/atomic.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+// ASM fetch_add: lock[ \t]+xadd
+// ASM-NOT fetch_add: call|mfence
+extern "C" auto fetch_add(std::uint32_t &x) -> std::uint32_t {
+    return atomic::fetch_add(x, 1u);
+}
+
+// ASM fetch_sub_release: lock[ \t]+xadd
+// ASM-NOT fetch_sub_release: call|mfence
+extern "C" auto fetch_sub_release(std::uint32_t &x) -> std::uint32_t {
+    return atomic::fetch_sub(x, 1u, std::memory_order_release);
+}
+
+// ASM load_acquire: mov
+// ASM-NOT load_acquire: call|lock|fence
+extern "C" auto load_acquire(std::uint32_t const &x) -> std::uint32_t {
+    return atomic::load(x, std::memory_order_acquire);
+}
+
+// ASM store_release: mov
+// ASM-NOT store_release: call|lock|xchg|fence
+extern "C" auto store_release(std::uint32_t &x, std::uint32_t v) -> void {
+    atomic::store(x, v, std::memory_order_release);
+}
+
+// ASM store_seq_cst: xchg|mfence
+// ASM-NOT store_seq_cst: call
+extern "C" auto store_seq_cst(std::uint32_t &x, std::uint32_t v) -> void {
+    atomic::store(x, v);
+}
+
+// ASM compare_exchange: lock[ \t]+cmpxchg
+// ASM-NOT compare_exchange: call
+extern "C" auto compare_exchange(std::uint64_t &x, std::uint64_t &expected,
+                                 std::uint64_t desired) -> bool {
+    return atomic::compare_exchange_strong(x, expected, desired);
+}
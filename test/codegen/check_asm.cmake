@@ -0,0 +1,61 @@
+# Compile SOURCE to assembly, then check the body of each function named in
+# its annotations:
+#
+#   // ASM <function>: <regex>      the body must match regex
+#   // ASM-NOT <function>: <regex>  the body must not match regex
+#
+# Functions are looked up by their unmangled name, so declare them extern "C".
+#
+# Required variables: CXX, STD, INCLUDE, SOURCE, WORK_DIR
+
+get_filename_component(name "${SOURCE}" NAME_WE)
+set(asm_file "${WORK_DIR}/${name}.s")
+
+execute_process(
+    COMMAND "${CXX}" -std=c++${STD} -O2 -S -I "${INCLUDE}" -o "${asm_file}"
+            "${SOURCE}"
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${errors}")
+endif()
+
+file(READ "${asm_file}" asm)
+file(STRINGS "${SOURCE}" annotations REGEX "^// ASM(-NOT)? [_a-zA-Z0-9]+: ")
+if(NOT annotations)
+    message(FATAL_ERROR "${SOURCE} has no ASM annotations")
+endif()
+
+set(failures 0)
+foreach(annotation ${annotations})
+    string(REGEX MATCH "^// (ASM(-NOT)?) ([_a-zA-Z0-9]+): (.*)$" _
+                 "${annotation}")
+    set(kind "${CMAKE_MATCH_1}")
+    set(function "${CMAKE_MATCH_3}")
+    set(regex "${CMAKE_MATCH_4}")
+
+    string(FIND "${asm}" "\n${function}:" start)
+    if(start EQUAL -1)
+        message(SEND_ERROR "${function}: not found in ${asm_file}")
+        math(EXPR failures "${failures} + 1")
+        continue()
+    endif()
+    string(SUBSTRING "${asm}" ${start} -1 body)
+    string(FIND "${body}" ".cfi_endproc" end)
+    string(SUBSTRING "${body}" 0 ${end} body)
+    # drop the labels, assembler directives and comments, leaving instructions
+    string(REGEX REPLACE "\n[ \t]*[.#][^\n]*" "" body "${body}")
+    string(REGEX REPLACE "^\n${function}:" "" body "${body}")
+
+    string(REGEX MATCH "${regex}" match "${body}")
+    if(kind STREQUAL "ASM" AND NOT match)
+        message(SEND_ERROR "${function}: expected /${regex}/ in:${body}")
+        math(EXPR failures "${failures} + 1")
+    elseif(kind STREQUAL "ASM-NOT" AND match)
+        message(SEND_ERROR "${function}: unexpected '${match}' in:${body}")
+        math(EXPR failures "${failures} + 1")
+    endif()
+endforeach()
+
+list(LENGTH annotations checks)
+message(STATUS "${name}: ${checks} checks, ${failures} failures")
@@ -0,0 +1,85 @@
+# Generate a translation unit with CALL_SITES critical sections, each with its
+# own per-call-site tag, then compile it at -O2 and check that:
+#
+#  - no function but the generated one is emitted, i.e. every instantiation of
+#    the library's wrappers (and of the critical sections) was inlined. The
+#    number of emitted functions stands in for a count of instantiations,
+#    which compilers do not report in a portable form
+#  - each call site costs at most INSTRUCTIONS_PER_SITE instructions, and the
+#    object file grows by at most BYTES_PER_SITE per call site
+#  - compilation takes at most MAX_SECONDS, measured to the second (CMake
+#    3.21 has no sub-second timestamps)
+#
+# The measurements are reported, so that they can be tracked over time.
+#
+# Required variables: CXX, STD, INCLUDE, POLICY, WORK_DIR, CALL_SITES,
+# INSTRUCTIONS_PER_SITE, BYTES_PER_SITE, MAX_SECONDS
+
+set(source "${WORK_DIR}/call_sites.cpp")
+set(object "${WORK_DIR}/call_sites.o")
+set(asm_file "${WORK_DIR}/call_sites.s")
+
+set(body "")
+foreach(i RANGE 1 ${CALL_SITES})
+    string(APPEND body
+           "    conc::call_in_critical_section([] { ++counters[${i}]; });\n")
+endforeach()
+file(
+    WRITE "${source}"
+    "#include \"${POLICY}\"\n\n"
+    "#include <conc/concurrency.hpp>\n\n"
+    "#include <cstdint>\n\n"
+    "std::uint32_t counters[${CALL_SITES} + 1];\n\n"
+    "extern \"C\" auto call_sites() -> void {\n"
+    "${body}"
+    "}\n")
+
+set(flags -std=c++${STD} -O2 -I "${INCLUDE}")
+
+string(TIMESTAMP start "%s" UTC)
+execute_process(
+    COMMAND "${CXX}" ${flags} -c -o "${object}" "${source}"
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors)
+string(TIMESTAMP end "%s" UTC)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Compiling ${source} failed:\n${errors}")
+endif()
+math(EXPR seconds "${end} - ${start}")
+
+execute_process(
+    COMMAND "${CXX}" ${flags} -S -o "${asm_file}" "${source}"
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Compiling ${source} failed:\n${errors}")
+endif()
+
+file(STRINGS "${asm_file}" functions REGEX "\\.type[ \t]+[^,]+,[ \t]*@function")
+list(LENGTH functions function_count)
+file(STRINGS "${asm_file}" instructions REGEX "^\t[a-z]")
+list(LENGTH instructions instruction_count)
+file(SIZE "${object}" object_size)
+
+message(
+    STATUS
+        "${CALL_SITES} call sites: ${function_count} function(s) emitted, "
+        "${instruction_count} instructions, object ${object_size} bytes, "
+        "compiled in ${seconds} s")
+
+if(NOT function_count EQUAL 1)
+    message(SEND_ERROR "expected only call_sites() to be emitted, got:\n"
+                       "${functions}")
+endif()
+math(EXPR max_instructions "16 + ${CALL_SITES} * ${INSTRUCTIONS_PER_SITE}")
+if(instruction_count GREATER max_instructions)
+    message(SEND_ERROR "${instruction_count} instructions; "
+                       "limit ${max_instructions}")
+endif()
+math(EXPR max_size "4096 + ${CALL_SITES} * ${BYTES_PER_SITE}")
+if(object_size GREATER max_size)
+    message(SEND_ERROR "object is ${object_size} bytes; limit ${max_size}")
+endif()
+if(seconds GREATER MAX_SECONDS)
+    message(SEND_ERROR "compilation took ${seconds} s; limit ${MAX_SECONDS} s")
+endif()
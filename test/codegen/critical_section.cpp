@@ -0,0 +1,37 @@
+#include "interrupt_policy.hpp"
+
+#include <conc/concurrency.hpp>
+
+#include <cstdint>
+
+// external linkage, so that accesses are not optimized away
+std::uint32_t counter{};
+bool ready{};
+
+// ASM increment: cli
+// ASM increment: sti
+// ASM-NOT increment: call|jmp[ \t]+[_a-zA-Z]
+extern "C" auto increment() -> void {
+    conc::call_in_critical_section([] { ++counter; });
+}
+
+// ASM read_counter: cli
+// ASM-NOT read_counter: call|jmp[ \t]+[_a-zA-Z]
+extern "C" auto read_counter() -> std::uint32_t {
+    return conc::call_in_critical_section([] { return counter; });
+}
+
+// ASM increment_when_ready: cli
+// ASM-NOT increment_when_ready: call|jmp[ \t]+[_a-zA-Z]
+extern "C" auto increment_when_ready() -> void {
+    conc::call_in_critical_section([] { ++counter; }, [] { return ready; });
+}
+
+// a critical section inside another, with a different tag
+// ASM nested: cli
+// ASM-NOT nested: call|jmp[ \t]+[_a-zA-Z]
+extern "C" auto nested() -> void {
+    conc::call_in_critical_section([] {
+        conc::call_in_critical_section([] { ++counter; });
+    });
+}
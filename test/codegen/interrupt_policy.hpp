@@ -0,0 +1,34 @@
+#pragma once
+
+#include <conc/concurrency.hpp>
+
+#include <concepts>
+#include <utility>
+
+// A bare-metal style policy: a critical section masks interrupts. The
+// instructions are only inspected, never executed.
+struct interrupt_policy {
+    struct [[nodiscard]] interrupt_guard {
+        interrupt_guard() { asm volatile("cli" ::: "memory"); }
+        ~interrupt_guard() { asm volatile("sti" ::: "memory"); }
+        interrupt_guard(interrupt_guard const &) = delete;
+        interrupt_guard(interrupt_guard &&) = delete;
+        auto operator=(interrupt_guard const &) -> interrupt_guard & = delete;
+        auto operator=(interrupt_guard &&) -> interrupt_guard & = delete;
+    };
+
+    template <typename = void, std::invocable F, std::predicate... Pred>
+        requires(sizeof...(Pred) < 2)
+    __attribute__((always_inline)) static auto
+    call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(std::forward<F>(f)()) {
+        while (true) {
+            [[maybe_unused]] interrupt_guard g{};
+            if ((... and pred())) {
+                return std::forward<F>(f)();
+            }
+        }
+    }
+};
+
+template <> inline auto conc::injected_policy<> = interrupt_policy{};
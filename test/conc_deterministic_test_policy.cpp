@@ -0,0 +1,183 @@
+#include <conc/deterministic_test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+
+TEST_CASE("deterministic test policy allows 'recursive' critical_sections",
+          "[deterministic_test_policy]") {
+    auto const value = conc::call_in_critical_section(
+        [] { return conc::call_in_critical_section([] { return 1; }); });
+    CHECK(value == 1);
+}
+
+namespace {
+struct count_CS;
+struct a_CS;
+struct b_CS;
+
+auto increment(int &count) -> void {
+    conc::call_in_critical_section<count_CS>([&] { ++count; });
+}
+
+// a lost update: the read and the write are in separate critical sections
+auto racy_increment(int &count) -> void {
+    auto const x =
+        conc::call_in_critical_section<count_CS>([&] { return count; });
+    conc::call_in_critical_section<count_CS>([&] { count = x + 1; });
+}
+
+template <auto Increment> auto count_to_n(conc::test_scheduler &s) -> bool {
+    constexpr auto N = 3;
+    auto count = 0;
+    for (auto i = 0; i < N; ++i) {
+        s.spawn([&] { Increment(count); });
+    }
+    s.join();
+    return count == N;
+}
+} // namespace
+
+TEST_CASE("deterministic test policy works", "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.seed = 17, .iterations = 100}, count_to_n<increment>);
+    CHECK(not r.failed);
+    CHECK(r.iterations == 100);
+}
+
+TEST_CASE("random strategy finds a lost update",
+          "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.seed = 17, .iterations = 100}, count_to_n<racy_increment>);
+    REQUIRE(r.failed);
+    CHECK(r.reason != nullptr);
+    CHECK(not r.schedule.empty());
+}
+
+TEST_CASE("a failure reproduces from its seed", "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.seed = 17, .iterations = 100}, count_to_n<racy_increment>);
+    REQUIRE(r.failed);
+
+    auto const replay = conc::test_scheduler::explore(
+        {.seed = r.seed, .iterations = 1}, count_to_n<racy_increment>);
+    CHECK(replay.failed);
+    CHECK(replay.schedule == r.schedule);
+}
+
+TEST_CASE("a failure reproduces from its schedule",
+          "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.seed = 17, .iterations = 100}, count_to_n<racy_increment>);
+    REQUIRE(r.failed);
+
+    auto const replay = conc::test_scheduler::explore(
+        {.strategy = conc::schedule_strategy::replay,
+         .iterations = 1,
+         .schedule = r.schedule},
+        count_to_n<racy_increment>);
+    CHECK(replay.failed);
+    CHECK(replay.schedule == r.schedule);
+}
+
+TEST_CASE("pct strategy finds a lost update", "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.strategy = conc::schedule_strategy::pct,
+         .seed = 17,
+         .iterations = 100,
+         .pct_steps = 10},
+        count_to_n<racy_increment>);
+    CHECK(r.failed);
+}
+
+TEST_CASE("exhaustive strategy explores all schedules",
+          "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.strategy = conc::schedule_strategy::exhaustive, .iterations = 10'000},
+        count_to_n<increment>);
+    CHECK(not r.failed);
+    CHECK(r.exhausted);
+    CHECK(r.iterations > 1);
+}
+
+TEST_CASE("exhaustive strategy finds a lost update",
+          "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.strategy = conc::schedule_strategy::exhaustive, .iterations = 10'000},
+        count_to_n<racy_increment>);
+    CHECK(r.failed);
+    CHECK(not r.exhausted);
+}
+
+TEST_CASE("deadlock is detected", "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.strategy = conc::schedule_strategy::exhaustive, .iterations = 10'000},
+        [](conc::test_scheduler &s) {
+            s.spawn([] {
+                conc::call_in_critical_section<a_CS>([] {
+                    conc::call_in_critical_section<b_CS>([] {});
+                });
+            });
+            s.spawn([] {
+                conc::call_in_critical_section<b_CS>([] {
+                    conc::call_in_critical_section<a_CS>([] {});
+                });
+            });
+        });
+    REQUIRE(r.failed);
+    CHECK(std::string_view{r.reason} == "deadlock");
+}
+
+namespace {
+auto wait_for_ready(conc::test_scheduler &s) -> bool {
+    auto ready = false;
+    auto value = 0;
+    s.spawn([&] {
+        conc::call_in_critical_section<count_CS>([&] { value = 17; },
+                                                 [&] { return ready; });
+    });
+    s.spawn([&] {
+        conc::call_in_critical_section<count_CS>([&] { ready = true; });
+    });
+    s.join();
+    return value == 17;
+}
+} // namespace
+
+TEST_CASE("predicate is used", "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.seed = 17, .iterations = 100}, wait_for_ready);
+    CHECK(not r.failed);
+}
+
+TEST_CASE("predicate is used with PCT", "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.strategy = conc::schedule_strategy::pct, .seed = 17,
+         .iterations = 100},
+        wait_for_ready);
+    CHECK(not r.failed);
+}
+
+TEST_CASE("predicate waits are explored exhaustively",
+          "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.strategy = conc::schedule_strategy::exhaustive, .iterations = 100},
+        wait_for_ready);
+    CHECK(not r.failed);
+    CHECK(r.exhausted);
+}
+
+TEST_CASE("a predicate that never becomes true is a deadlock",
+          "[deterministic_test_policy]") {
+    auto const r = conc::test_scheduler::explore(
+        {.strategy = conc::schedule_strategy::exhaustive, .iterations = 100},
+        [](conc::test_scheduler &s) {
+            s.spawn([] {
+                conc::call_in_critical_section<count_CS>([] {},
+                                                         [] { return false; });
+            });
+            s.spawn([] { conc::call_in_critical_section<count_CS>([] {}); });
+        });
+    REQUIRE(r.failed);
+    CHECK(std::string_view{r.reason} == "deadlock");
+}
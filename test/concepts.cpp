@@ -82,6 +82,26 @@ struct atomic_bitwise_policy : atomic_load_store_policy {
 struct atomic_policy : atomic_exchange_policy,
                        atomic_add_sub_policy,
                        atomic_bitwise_policy {};
+
+struct atomic_compare_exchange_policy : atomic_load_store_policy {
+    template <typename T>
+    static auto
+    compare_exchange_strong(T &t, T &expected, T &desired,
+                            std::memory_order success = std::memory_order_seq_cst,
+                            std::memory_order failure = std::memory_order_seq_cst)
+        -> bool;
+    template <typename T>
+    static auto
+    compare_exchange_weak(T &t, T &expected, T &desired,
+                          std::memory_order success = std::memory_order_seq_cst,
+                          std::memory_order failure = std::memory_order_seq_cst)
+        -> bool;
+};
+
+struct atomic_fence_policy {
+    static auto thread_fence(std::memory_order mo = std::memory_order_seq_cst)
+        -> void;
+};
 } // namespace
 
 TEST_CASE("good atomic policies", "[concepts]") {
@@ -91,6 +111,9 @@ TEST_CASE("good atomic policies", "[concepts]") {
     STATIC_REQUIRE(atomic::bitwise_policy<atomic_bitwise_policy>);
     STATIC_REQUIRE(atomic::policy<atomic_policy>);
     STATIC_REQUIRE(not atomic::policy<not_a_policy>);
+    STATIC_REQUIRE(
+        atomic::compare_exchange_policy<atomic_compare_exchange_policy>);
+    STATIC_REQUIRE(atomic::fence_policy<atomic_fence_policy>);
 }
 
 namespace {
@@ -117,6 +140,19 @@ struct bad_exchange_policy_no_return : atomic_load_store_policy {
                          std::memory_order mo = std::memory_order_seq_cst)
         -> void;
 };
+
+struct bad_compare_exchange_policy_no_weak : atomic_load_store_policy {
+    template <typename T>
+    static auto
+    compare_exchange_strong(T &t, T &expected, T &desired,
+                            std::memory_order success = std::memory_order_seq_cst,
+                            std::memory_order failure = std::memory_order_seq_cst)
+        -> bool;
+};
+
+struct bad_fence_policy_no_memory_order {
+    static auto thread_fence() -> void;
+};
 } // namespace
 
 TEST_CASE("bad atomic policies", "[concepts]") {
@@ -127,4 +163,8 @@ TEST_CASE("bad atomic policies", "[concepts]") {
     STATIC_REQUIRE(
         not atomic::load_store_policy<bad_load_store_policy_no_memory_order>);
     STATIC_REQUIRE(not atomic::exchange_policy<bad_exchange_policy_no_return>);
+    STATIC_REQUIRE(not atomic::compare_exchange_policy<
+                   bad_compare_exchange_policy_no_weak>);
+    STATIC_REQUIRE(
+        not atomic::fence_policy<bad_fence_policy_no_memory_order>);
 }
@@ -0,0 +1,172 @@
+#include <conc/concepts.hpp>
+#include <conc/concurrency.hpp>
+#include <conc/delegation.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+template <>
+inline auto conc::injected_policy<> = conc::delegation_policy<4>{};
+
+TEST_CASE("delegation policy models policy", "[delegation_policy]") {
+    STATIC_REQUIRE(conc::policy<conc::delegation_policy<>>);
+}
+
+TEST_CASE("critical sections run on another thread", "[delegation_policy]") {
+    struct other_CS;
+    auto const id = conc::call_in_critical_section<other_CS>(
+        [] { return std::this_thread::get_id(); });
+    CHECK(id != std::this_thread::get_id());
+}
+
+TEST_CASE("critical sections for a tag run on the same thread",
+          "[delegation_policy]") {
+    struct same_CS;
+    auto const id1 = conc::call_in_critical_section<same_CS>(
+        [] { return std::this_thread::get_id(); });
+    auto const id2 = conc::call_in_critical_section<same_CS>(
+        [] { return std::this_thread::get_id(); });
+    CHECK(id1 == id2);
+}
+
+TEST_CASE("critical sections for different tags run on different threads",
+          "[delegation_policy]") {
+    struct first_CS;
+    struct second_CS;
+    auto const id1 = conc::call_in_critical_section<first_CS>(
+        [] { return std::this_thread::get_id(); });
+    auto const id2 = conc::call_in_critical_section<second_CS>(
+        [] { return std::this_thread::get_id(); });
+    CHECK(id1 != id2);
+}
+
+TEST_CASE("critical sections for different tags may nest",
+          "[delegation_policy]") {
+    struct outer_CS;
+    struct middle_CS;
+    struct inner_CS;
+    auto const value = conc::call_in_critical_section<outer_CS>([] {
+        return conc::call_in_critical_section<middle_CS>([] {
+            return conc::call_in_critical_section<inner_CS>([] { return 1; });
+        });
+    });
+    CHECK(value == 1);
+}
+
+TEST_CASE("critical sections return values and references",
+          "[delegation_policy]") {
+    struct result_CS;
+    CHECK(conc::call_in_critical_section<result_CS>([] { return 17; }) == 17);
+
+    auto p = conc::call_in_critical_section<result_CS>(
+        [] { return std::make_unique<int>(42); });
+    REQUIRE(p != nullptr);
+    CHECK(*p == 42);
+
+    int x{};
+    int &r = conc::call_in_critical_section<result_CS>(
+        [&]() -> int & { return x; });
+    CHECK(&r == &x);
+}
+
+TEST_CASE("exceptions propagate to the caller", "[delegation_policy]") {
+    struct throw_CS;
+    auto thrown = false;
+    try {
+        conc::call_in_critical_section<throw_CS>(
+            [] { throw std::runtime_error{"delegated"}; });
+    } catch (std::runtime_error const &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+TEST_CASE("critical sections may nest", "[delegation_policy]") {
+    struct nest_CS;
+    auto const value = conc::call_in_critical_section<nest_CS>([] {
+        return conc::call_in_critical_section<nest_CS>([] { return 1; });
+    });
+    CHECK(value == 1);
+}
+
+TEST_CASE("critical sections use the predicate", "[delegation_policy]") {
+    struct pred_CS;
+    auto ready = false;
+    std::uint32_t result{};
+
+    std::thread t{[&] {
+        result = conc::call_in_critical_section<pred_CS>([] { return 17u; },
+                                                         [&] { return ready; });
+    }};
+    conc::call_in_critical_section<pred_CS>([&] { ready = true; });
+    t.join();
+    CHECK(result == 17);
+}
+
+TEST_CASE("critical sections are mutually exclusive with more threads than "
+          "mailboxes",
+          "[delegation_policy]") {
+    struct count_CS;
+    constexpr auto threads = 8u;
+    constexpr auto increments = 1'000u;
+    std::uint32_t count{};
+
+    std::vector<std::thread> ts{};
+    for (auto i = 0u; i < threads; ++i) {
+        ts.emplace_back([&] {
+            for (auto j = 0u; j < increments; ++j) {
+                conc::call_in_critical_section<count_CS>([&] { ++count; });
+            }
+        });
+    }
+    for (auto &t : ts) {
+        t.join();
+    }
+    CHECK(count == threads * increments);
+}
+
+TEST_CASE("predicates made true outside critical sections are noticed",
+          "[delegation_policy]") {
+    struct flag_CS;
+    std::atomic<bool> ready{};
+    std::thread t{[&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        ready = true;
+    }};
+    auto const value = conc::call_in_critical_section<flag_CS>(
+        [] { return 17; }, [&] { return ready.load(); });
+    t.join();
+    CHECK(value == 17);
+}
+
+TEST_CASE("more threads than mailboxes may be alive at once",
+          "[delegation_policy]") {
+    struct alive_CS;
+    constexpr auto threads = 12u;
+    std::uint32_t count{};
+    std::latch all_called{threads};
+
+    std::vector<std::thread> ts{};
+    for (auto i = 0u; i < threads; ++i) {
+        ts.emplace_back([&] {
+            conc::call_in_critical_section<alive_CS>([&] { ++count; });
+            // keep the thread (and any mailbox it owns) alive until every
+            // thread has made a call
+            all_called.arrive_and_wait();
+            conc::call_in_critical_section<alive_CS>([&] { ++count; });
+        });
+    }
+    for (auto &t : ts) {
+        t.join();
+    }
+    CHECK(count == 2 * threads);
+}
@@ -0,0 +1,87 @@
+#include <conc/atomic.hpp>
+#include <conc/eventcount.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST_CASE("notify without waiters does nothing", "[eventcount]") {
+    conc::eventcount ec{};
+    ec.notify();
+}
+
+TEST_CASE("a cancelled wait does not block", "[eventcount]") {
+    conc::eventcount ec{};
+    [[maybe_unused]] auto const k = ec.prepare_wait();
+    ec.cancel_wait();
+    ec.notify();
+}
+
+TEST_CASE("a notify after prepare_wait ends commit_wait", "[eventcount]") {
+    conc::eventcount ec{};
+    auto const k = ec.prepare_wait();
+    ec.notify();
+    ec.commit_wait(k);
+}
+
+TEST_CASE("await returns once the condition holds", "[eventcount]") {
+    conc::eventcount ec{};
+    std::uint32_t ready{};
+    std::thread t{[&] {
+        std::this_thread::yield();
+        atomic::store(ready, 1u);
+        ec.notify();
+    }};
+    ec.await([&] { return atomic::load(ready) != 0; });
+    CHECK(atomic::load(ready) == 1);
+    t.join();
+}
+
+TEST_CASE("consumers wait for a lock-free counter", "[eventcount]") {
+    constexpr auto consumers = 3u;
+    constexpr auto items = 10'000u;
+    conc::eventcount ec{};
+    std::uint32_t available{};
+    std::uint32_t consumed{};
+
+    auto const try_take = [&] {
+        auto n = atomic::load(available);
+        while (n != 0) {
+            if (atomic::compare_exchange_weak(available, n, n - 1)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<std::thread> threads{};
+    for (auto i = 0u; i < consumers; ++i) {
+        threads.emplace_back([&] {
+            while (true) {
+                ec.await([&] {
+                    return atomic::load(consumed) >= items or
+                           atomic::load(available) != 0;
+                });
+                if (atomic::load(consumed) >= items) {
+                    return;
+                }
+                if (try_take() and
+                    atomic::fetch_add(consumed, 1u) + 1 == items) {
+                    ec.notify();
+                }
+            }
+        });
+    }
+
+    for (auto i = 0u; i < items; ++i) {
+        atomic::fetch_add(available, 1u);
+        ec.notify();
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    CHECK(consumed == items);
+    CHECK(available == 0);
+}
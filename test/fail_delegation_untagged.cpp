@@ -0,0 +1,11 @@
+#include <conc/concurrency.hpp>
+#include <conc/delegation.hpp>
+
+// EXPECT: name the tag of this critical section
+
+template <>
+inline auto conc::injected_policy<> = conc::delegation_policy<>{};
+
+auto main() -> int {
+    [[maybe_unused]] auto v = conc::call_in_critical_section([] { return 1; });
+}
@@ -0,0 +1,14 @@
+#include <conc/atomic.hpp>
+
+// EXPECT: This atomic operation is not lock-free
+
+template <> constexpr inline auto atomic::strict_lock_free<> = true;
+
+namespace {
+struct big {
+    char data[64];
+};
+big b{};
+} // namespace
+
+auto main() -> int { [[maybe_unused]] auto v = atomic::load(b); }
@@ -69,3 +69,11 @@ TEST_CASE("predicate is used", "[hosted_injected_policy]") {
     CHECK(v == 17);
     CHECK(predicate_used == 1);
 }
+
+TEST_CASE("read section falls back to critical section",
+          "[hosted_injected_policy]") {
+    STATIC_REQUIRE(not conc::read_section_policy<custom_policy>);
+    auto c = custom_policy::count;
+    CHECK(conc::call_in_read_section([] { return 17; }) == 17);
+    CHECK(custom_policy::count - c == 1);
+}
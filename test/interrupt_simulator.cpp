@@ -0,0 +1,130 @@
+#include <conc/concepts.hpp>
+#include <conc/concurrency.hpp>
+#include <conc/interrupt_simulator.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+template <> inline auto conc::injected_policy<> = conc::interrupt_mask_policy<>{};
+
+namespace {
+std::atomic<std::uint32_t> isr_count{};
+std::uint32_t volatile shared{};
+
+auto count_isr() -> void { isr_count.fetch_add(1, std::memory_order_relaxed); }
+
+auto increment_isr() -> void {
+    count_isr();
+    shared = shared + 1;
+}
+
+auto spin_for(std::chrono::microseconds d) -> void {
+    auto const end = std::chrono::steady_clock::now() + d;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// spin until pred() is true; the timeout only guards against a hang
+template <typename P> auto eventually(P &&pred) -> bool {
+    auto const end = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (not pred()) {
+        if (std::chrono::steady_clock::now() > end) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("interrupt mask policy models concept", "[interrupt_simulator]") {
+    STATIC_REQUIRE(conc::policy<conc::interrupt_mask_policy<>>);
+}
+
+TEST_CASE("interrupts are delivered to the constructing thread",
+          "[interrupt_simulator]") {
+    isr_count = 0;
+    {
+        conc::interrupt_simulator sim{count_isr,
+                                      {.period = std::chrono::microseconds{200},
+                                       .jitter = std::chrono::microseconds{50},
+                                       .seed = 17}};
+        REQUIRE(eventually([] { return isr_count >= 10; }));
+    }
+    auto const s = conc::interrupt_simulator::stats();
+    CHECK(s.delivered == isr_count);
+    CHECK(s.max_latency >= s.mean_latency());
+}
+
+TEST_CASE("critical sections mask interrupts", "[interrupt_simulator]") {
+    isr_count = 0;
+    conc::interrupt_mask_policy<>::reset_longest_section();
+    conc::interrupt_simulator sim{count_isr,
+                                  {.period = std::chrono::microseconds{100}}};
+    REQUIRE(eventually([] { return isr_count > 0; }));
+
+    auto const [before, after] = conc::call_in_critical_section([] {
+        CHECK(conc::interrupt_mask_policy<>::in_critical_section());
+        auto const b = isr_count.load();
+        // an interrupt raised while another is held pending is coalesced
+        CHECK(eventually(
+            [] { return conc::interrupt_simulator::stats().coalesced > 0; }));
+        spin_for(std::chrono::milliseconds{1});
+        return std::pair{b, isr_count.load()};
+    });
+    CHECK(before == after);
+    CHECK(not conc::interrupt_mask_policy<>::in_critical_section());
+
+    // the pending interrupt is delivered as soon as it is unmasked
+    CHECK(isr_count > after);
+    CHECK(conc::interrupt_mask_policy<>::longest_section() >=
+          std::chrono::milliseconds{1});
+    CHECK(conc::interrupt_simulator::stats().max_latency >=
+          std::chrono::milliseconds{1});
+}
+
+TEST_CASE("a simulator can be destroyed with an interrupt masked",
+          "[interrupt_simulator]") {
+    isr_count = 0;
+    conc::call_in_critical_section([] {
+        conc::interrupt_simulator sim{
+            count_isr, {.period = std::chrono::microseconds{100}}};
+        CHECK(eventually(
+            [] { return conc::interrupt_simulator::stats().coalesced > 0; }));
+    });
+    CHECK(isr_count == 0);
+}
+
+TEST_CASE("data shared with an ISR is protected by critical sections",
+          "[interrupt_simulator]") {
+    isr_count = 0;
+    shared = 0;
+    constexpr auto min_iterations = 100'000u;
+    constexpr auto min_interrupts = 100u;
+    auto iterations = 0u;
+    {
+        conc::interrupt_simulator sim{
+            increment_isr, {.period = std::chrono::microseconds{50}}};
+        REQUIRE(eventually([&] {
+            conc::call_in_critical_section([] { shared = shared + 1; });
+            return ++iterations >= min_iterations and
+                   isr_count >= min_interrupts;
+        }));
+    }
+    CHECK(shared == iterations + isr_count);
+}
+
+TEST_CASE("in_isr identifies the interrupt context", "[interrupt_simulator]") {
+    static std::atomic<bool> was_in_isr{};
+    CHECK(not conc::interrupt_simulator::in_isr());
+    {
+        conc::interrupt_simulator sim{
+            [] { was_in_isr = conc::interrupt_simulator::in_isr(); },
+            {.period = std::chrono::microseconds{100}}};
+        CHECK(eventually([] { return was_in_isr.load(); }));
+    }
+    CHECK(not conc::interrupt_simulator::in_isr());
+}
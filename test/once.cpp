@@ -0,0 +1,137 @@
+#include <conc/concepts.hpp>
+#include <conc/concurrency.hpp>
+#include <conc/once.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace {
+struct counting_policy {
+    static inline std::uint32_t count{};
+    static inline std::mutex m{};
+
+    template <typename = void, std::invocable F, std::predicate... Pred>
+        requires(sizeof...(Pred) < 2)
+    static inline auto call_in_critical_section(F &&f, Pred &&...pred)
+        -> decltype(std::forward<F>(f)()) {
+        while (true) {
+            [[maybe_unused]] std::lock_guard l{m};
+            ++count;
+            if ((... and pred())) {
+                return std::forward<F>(f)();
+            }
+        }
+    }
+};
+} // namespace
+
+template <> inline auto conc::injected_policy<> = counting_policy{};
+
+namespace {
+struct once_tag;
+struct threaded_once_tag;
+struct throwing_once_tag;
+} // namespace
+
+TEST_CASE("call_once calls once", "[once]") {
+    auto calls = 0;
+    conc::call_once<once_tag>([&] { ++calls; });
+    conc::call_once<once_tag>([&] { ++calls; });
+    CHECK(calls == 1);
+}
+
+TEST_CASE("call_once fast path does not enter a critical section", "[once]") {
+    conc::call_once<once_tag>([] {});
+    auto const c = counting_policy::count;
+    conc::call_once<once_tag>([] {});
+    CHECK(counting_policy::count == c);
+}
+
+TEST_CASE("call_once calls once across threads", "[once]") {
+    constexpr auto N = 10u;
+    auto calls = 0;
+    std::array<std::thread, N> threads{};
+    for (auto &t : threads) {
+        t = std::thread{
+            [&] { conc::call_once<threaded_once_tag>([&] { ++calls; }); }};
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    CHECK(calls == 1);
+}
+
+TEST_CASE("call_once retries after an exception", "[once]") {
+    auto calls = 0;
+    try {
+        conc::call_once<throwing_once_tag>([&] {
+            ++calls;
+            throw 0;
+        });
+    } catch (int) {
+    }
+    conc::call_once<throwing_once_tag>([&] { ++calls; });
+    conc::call_once<throwing_once_tag>([&] { ++calls; });
+    CHECK(calls == 2);
+}
+
+TEST_CASE("once flag honours atomic type and alignment", "[once]") {
+    STATIC_REQUIRE(
+        std::is_same_v<std::remove_cvref_t<decltype(conc::detail::once_flag<
+                                                     once_tag>)>,
+                       std::uint32_t>);
+    STATIC_REQUIRE(alignof(decltype(conc::detail::once_flag<once_tag>)) >=
+                   atomic::alignment_of<bool>);
+}
+
+namespace {
+struct counted {
+    static inline auto constructed = 0;
+    static inline auto destroyed = 0;
+    int value;
+    explicit counted(int v) : value{v} { ++constructed; }
+    counted(counted const &) = delete;
+    counted(counted &&) = delete;
+    auto operator=(counted const &) -> counted & = delete;
+    auto operator=(counted &&) -> counted & = delete;
+    ~counted() { ++destroyed; }
+};
+
+struct value_tag;
+} // namespace
+
+TEST_CASE("lazy constructs on first access", "[once]") {
+    counted::constructed = 0;
+    counted::destroyed = 0;
+    {
+        conc::lazy<counted, value_tag> l{};
+        CHECK(not l.has_value());
+        CHECK(counted::constructed == 0);
+
+        CHECK(l.get(17).value == 17);
+        CHECK(l.has_value());
+        CHECK(l.get(42).value == 17);
+        CHECK(counted::constructed == 1);
+    }
+    CHECK(counted::destroyed == 1);
+}
+
+TEST_CASE("lazy fast path does not enter a critical section", "[once]") {
+    conc::lazy<int, value_tag> l{};
+    CHECK(l.get(17) == 17);
+    auto const c = counting_policy::count;
+    CHECK(*l == 17);
+    CHECK(counting_policy::count == c);
+}
+
+TEST_CASE("lazy is constant-initialized", "[once]") {
+    static constinit conc::lazy<std::pair<int, int>, value_tag> l{};
+    CHECK(l->first == 0);
+}
@@ -0,0 +1,92 @@
+#include <conc/atomic.hpp>
+#include <conc/parking_lot.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+TEST_CASE("park does not sleep when validation fails", "[parking_lot]") {
+    auto validated = false;
+    int x{};
+    conc::park(&x, [&] {
+        validated = true;
+        return false;
+    });
+    CHECK(validated);
+}
+
+TEST_CASE("unpark_all with no waiters does nothing", "[parking_lot]") {
+    int x{};
+    auto const &b = conc::detail::bucket_for(&x);
+    auto const epoch = b.epoch;
+    conc::unpark_all(&x);
+    CHECK(b.epoch == epoch);
+}
+
+TEST_CASE("unpark_all wakes parked threads", "[parking_lot]") {
+    constexpr auto waiters = 4u;
+    std::uint32_t flag{};
+    std::uint32_t woken{};
+
+    std::vector<std::thread> threads{};
+    for (auto i = 0u; i < waiters; ++i) {
+        threads.emplace_back([&] {
+            while (atomic::load(flag) == 0) {
+                conc::park(&flag, [&] { return atomic::load(flag) == 0; });
+            }
+            atomic::fetch_add(woken, 1u);
+        });
+    }
+
+    atomic::store(flag, 1u);
+    conc::unpark_all(&flag);
+    for (auto &t : threads) {
+        t.join();
+    }
+    CHECK(woken == waiters);
+    CHECK(conc::detail::bucket_for(&flag).waiters == 0);
+}
+
+TEST_CASE("addresses sharing a bucket do not lose wakeups", "[parking_lot]") {
+    std::vector<std::uint32_t> flags(1024);
+    auto &first = flags.front();
+    auto &bucket = conc::detail::bucket_for(&first);
+    auto const it = std::find_if(
+        std::next(flags.begin()), flags.end(), [&](std::uint32_t const &f) {
+            return &conc::detail::bucket_for(&f) == &bucket;
+        });
+    REQUIRE(it != flags.end());
+    auto &second = *it;
+
+    std::atomic<std::uint32_t> done{};
+    auto const wait_on = [&](std::uint32_t &f) {
+        return std::thread{[&] {
+            while (atomic::load(f) == 0) {
+                conc::park(&f, [&] { return atomic::load(f) == 0; });
+            }
+            ++done;
+        }};
+    };
+    auto t1 = wait_on(first);
+    auto t2 = wait_on(second);
+    while (atomic::load(bucket.waiters) != 2) {
+        std::this_thread::yield();
+    }
+
+    // waking one address also wakes the other, which must park again
+    atomic::store(first, 1u);
+    conc::unpark_all(&first);
+    t1.join();
+    CHECK(done == 1);
+
+    atomic::store(second, 1u);
+    conc::unpark_all(&second);
+    t2.join();
+    CHECK(done == 2);
+    CHECK(bucket.waiters == 0);
+}
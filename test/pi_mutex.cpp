@@ -0,0 +1,141 @@
+#include <conc/concepts.hpp>
+#include <conc/concurrency.hpp>
+#include <conc/pi_mutex.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+
+template <>
+inline auto conc::injected_policy<> = conc::priority_inheritance_policy{};
+
+namespace {
+// a critical section entered during dynamic initialization
+auto const initialized_value = conc::call_in_critical_section<struct init_CS>(
+    [] { return 17; });
+
+// the scheduling priority of the calling thread, as the kernel sees it, from
+// field 18 of /proc/thread-self/stat: 20 for an ordinary thread, -1 - p for a
+// real-time thread of priority p
+auto effective_priority() -> int {
+    std::ifstream f{"/proc/thread-self/stat"};
+    std::string const stat{std::istreambuf_iterator<char>{f}, {}};
+    // fields after the command name (in parentheses) are space-separated
+    auto pos = stat.rfind(')') + 2;
+    for (auto field = 3; field < 18; ++field) {
+        pos = stat.find(' ', pos) + 1;
+    }
+    return std::stoi(stat.substr(pos));
+}
+} // namespace
+
+TEST_CASE("priority inheritance policy models concept", "[pi_mutex]") {
+    STATIC_REQUIRE(conc::policy<conc::priority_inheritance_policy>);
+}
+
+TEST_CASE("pi_mutex is lockable", "[pi_mutex]") {
+    conc::pi_mutex m{};
+    {
+        std::lock_guard l{m};
+        auto locked_elsewhere = true;
+        std::thread{[&] {
+            locked_elsewhere = not m.try_lock();
+        }}.join();
+        CHECK(locked_elsewhere);
+    }
+    CHECK(m.try_lock());
+    m.unlock();
+}
+
+TEST_CASE("pi_mutex uses the priority-inheritance protocol", "[pi_mutex]") {
+    conc::pi_mutex::attributes attr{};
+    auto protocol = 0;
+    REQUIRE(pthread_mutexattr_getprotocol(attr.native_handle(), &protocol) ==
+            0);
+    CHECK(protocol == PTHREAD_PRIO_INHERIT);
+}
+
+TEST_CASE("a pi_mutex owner inherits the priority of a waiter",
+          "[pi_mutex]") {
+    constexpr auto waiter_priority = 10;
+    conc::pi_mutex m{};
+    std::unique_lock l{m};
+    auto const base = effective_priority();
+
+    std::atomic<bool> permitted{true};
+    std::thread waiter{[&] {
+        sched_param const param{.sched_priority = waiter_priority};
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+            permitted = false;
+            return;
+        }
+        std::lock_guard wl{m};
+    }};
+
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    auto boosted = base;
+    while (permitted and boosted == base and
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+        boosted = effective_priority();
+    }
+    l.unlock();
+    waiter.join();
+
+    if (not permitted) {
+        WARN("not permitted to create a SCHED_FIFO thread");
+        return;
+    }
+    CHECK(boosted == -1 - waiter_priority);
+    CHECK(effective_priority() == base);
+}
+
+TEST_CASE("critical sections may be used during dynamic initialization",
+          "[pi_mutex]") {
+    CHECK(initialized_value == 17);
+}
+
+TEST_CASE("critical sections return values", "[pi_mutex]") {
+    CHECK(conc::call_in_critical_section([] { return 17; }) == 17);
+}
+
+TEST_CASE("the predicate is used", "[pi_mutex]") {
+    auto predicate_used = 0;
+    auto v = conc::call_in_critical_section([] { return 17; },
+                                            [&] {
+                                                ++predicate_used;
+                                                return true;
+                                            });
+    CHECK(v == 17);
+    CHECK(predicate_used == 1);
+}
+
+TEST_CASE("critical sections exclude each other", "[pi_mutex]") {
+    struct count_CS;
+    constexpr auto iterations = 10'000u;
+    std::uint32_t count{};
+    std::array<std::thread, 4> threads{};
+    for (auto &t : threads) {
+        t = std::thread{[&] {
+            for (auto i = 0u; i < iterations; ++i) {
+                conc::call_in_critical_section<count_CS>([&] { ++count; });
+            }
+        }};
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    CHECK(count == threads.size() * iterations);
+}
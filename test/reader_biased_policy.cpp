@@ -0,0 +1,88 @@
+#include <conc/concepts.hpp>
+#include <conc/concurrency.hpp>
+#include <conc/reader_biased.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+template <>
+inline auto conc::injected_policy<> = conc::reader_biased_policy<>{};
+
+TEST_CASE("reader biased policy models concepts", "[reader_biased_policy]") {
+    STATIC_REQUIRE(conc::policy<conc::reader_biased_policy<>>);
+    STATIC_REQUIRE(conc::read_section_policy<conc::reader_biased_policy<>>);
+}
+
+TEST_CASE("read sections return values", "[reader_biased_policy]") {
+    CHECK(conc::call_in_read_section([] { return 17; }) == 17);
+}
+
+TEST_CASE("read sections may nest", "[reader_biased_policy]") {
+    struct nest_CS;
+    auto const value = conc::call_in_read_section<nest_CS>(
+        [] { return conc::call_in_read_section<nest_CS>([] { return 1; }); });
+    CHECK(value == 1);
+}
+
+TEST_CASE("critical sections use the predicate", "[reader_biased_policy]") {
+    auto predicate_used = 0;
+    auto v = conc::call_in_critical_section([] { return 17; },
+                                            [&] {
+                                                ++predicate_used;
+                                                return true;
+                                            });
+    CHECK(v == 17);
+    CHECK(predicate_used == 1);
+}
+
+namespace {
+struct pair_CS;
+struct pair_t {
+    std::uint64_t a{};
+    std::uint64_t b{};
+};
+} // namespace
+
+TEST_CASE("readers never see a partial write", "[reader_biased_policy]") {
+    constexpr auto readers = 3u;
+    constexpr auto writes = 1'000u;
+    pair_t data{};
+    std::atomic<bool> done{};
+    std::atomic<std::uint32_t> torn{};
+    std::atomic<std::uint64_t> reads{};
+
+    std::array<std::thread, readers> threads{};
+    for (auto &t : threads) {
+        t = std::thread{[&] {
+            while (not done) {
+                conc::call_in_read_section<pair_CS>([&] {
+                    if (data.a != data.b) {
+                        ++torn;
+                    }
+                });
+                ++reads;
+            }
+        }};
+    }
+
+    for (auto i = 0u; i < writes; ++i) {
+        conc::call_in_critical_section<pair_CS>([&] {
+            ++data.a;
+            std::this_thread::yield();
+            ++data.b;
+        });
+    }
+    done = true;
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    CHECK(torn == 0);
+    CHECK(reads > 0);
+    CHECK(data.a == writes);
+    CHECK(data.b == writes);
+}
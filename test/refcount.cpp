@@ -0,0 +1,94 @@
+#include <conc/refcount.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace {
+struct object : conc::refcount {
+    explicit object(int v, int &d) : value{v}, destroyed{d} {}
+    object(object const &) = delete;
+    object(object &&) = delete;
+    auto operator=(object const &) -> object & = delete;
+    auto operator=(object &&) -> object & = delete;
+    ~object() { ++destroyed; }
+
+    int value;
+    int &destroyed;
+};
+} // namespace
+
+TEST_CASE("refcount models refcounted", "[refcount]") {
+    STATIC_REQUIRE(conc::refcounted<conc::refcount>);
+}
+
+TEST_CASE("the last release is reported", "[refcount]") {
+    conc::refcount r{};
+    CHECK(r.use_count() == 1);
+    r.add_ref();
+    CHECK(r.use_count() == 2);
+    CHECK(not r.release());
+    CHECK(r.release());
+}
+
+TEST_CASE("intrusive_ptr destroys the object with the last reference",
+          "[refcount]") {
+    auto destroyed = 0;
+    {
+        auto p = conc::make_intrusive<object>(17, destroyed);
+        CHECK(p->value == 17);
+        CHECK(p->use_count() == 1);
+        {
+            auto q = p;
+            CHECK(q == p);
+            CHECK(p->use_count() == 2);
+        }
+        CHECK(p->use_count() == 1);
+        auto m = std::move(p);
+        CHECK(p == nullptr);
+        CHECK(m->use_count() == 1);
+        CHECK(destroyed == 0);
+    }
+    CHECK(destroyed == 1);
+}
+
+TEST_CASE("intrusive_ptr can be reset and detached", "[refcount]") {
+    auto destroyed = 0;
+    auto p = conc::make_intrusive<object>(1, destroyed);
+    auto q = p;
+    p.reset();
+    CHECK(not p);
+    CHECK(destroyed == 0);
+
+    auto *raw = q.detach();
+    CHECK(not q);
+    CHECK(destroyed == 0);
+    conc::intrusive_ptr<object> r{raw};
+    r = nullptr;
+    CHECK(destroyed == 1);
+}
+
+TEST_CASE("references can be shared between threads", "[refcount]") {
+    constexpr auto threads = 4u;
+    constexpr auto copies = 10'000u;
+    auto destroyed = 0;
+    {
+        auto p = conc::make_intrusive<object>(1, destroyed);
+        std::array<std::thread, threads> ts{};
+        for (auto &t : ts) {
+            t = std::thread{[p] {
+                for (auto i = 0u; i < copies; ++i) {
+                    [[maybe_unused]] auto q = p;
+                }
+            }};
+        }
+        for (auto &t : ts) {
+            t.join();
+        }
+        CHECK(p->use_count() == 1);
+    }
+    CHECK(destroyed == 1);
+}
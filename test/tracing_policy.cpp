@@ -0,0 +1,149 @@
+#include <conc/concepts.hpp>
+#include <conc/concurrency.hpp>
+#include <conc/tracing.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+template <> inline auto conc::injected_policy<> = conc::tracing_policy<>{};
+
+namespace {
+struct traced_CS;
+
+auto count(std::string const &s, std::string_view sub) -> std::size_t {
+    auto n = std::size_t{};
+    for (auto pos = s.find(sub); pos != std::string::npos;
+         pos = s.find(sub, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+template <typename P> auto events() {
+    std::vector<std::pair<std::size_t, conc::trace_event>> v{};
+    P::for_each([&](std::size_t tid, conc::trace_event const &e) {
+        v.emplace_back(tid, e);
+    });
+    return v;
+}
+} // namespace
+
+TEST_CASE("tracing policy models concept", "[tracing_policy]") {
+    STATIC_REQUIRE(conc::policy<conc::tracing_policy<>>);
+}
+
+TEST_CASE("critical sections are traced", "[tracing_policy]") {
+    using P = conc::tracing_policy<>;
+    P::reset();
+    CHECK(conc::call_in_critical_section<traced_CS>([] { return 17; }) == 17);
+
+    auto const v = events<P>();
+    REQUIRE(v.size() == 3);
+    CHECK(v[0].second.kind == conc::trace_kind::enter);
+    CHECK(v[1].second.kind == conc::trace_kind::acquire);
+    CHECK(v[2].second.kind == conc::trace_kind::release);
+    CHECK(v[0].second.timestamp <= v[1].second.timestamp);
+    CHECK(v[1].second.timestamp <= v[2].second.timestamp);
+    for (auto const &[tid, e] : v) {
+        CHECK(e.name.find("traced_CS") != std::string_view::npos);
+    }
+}
+
+TEST_CASE("the predicate is used", "[tracing_policy]") {
+    auto predicate_used = 0;
+    auto v = conc::call_in_critical_section([] { return 17; },
+                                            [&] {
+                                                ++predicate_used;
+                                                return true;
+                                            });
+    CHECK(v == 17);
+    CHECK(predicate_used == 1);
+}
+
+TEST_CASE("traces are written as Chrome trace-event JSON",
+          "[tracing_policy]") {
+    using P = conc::tracing_policy<>;
+    P::reset();
+    conc::call_in_critical_section<traced_CS>([] {});
+
+    std::ostringstream os{};
+    P::write_chrome_trace(os);
+    auto const s = os.str();
+    CHECK(s.starts_with(R"({"displayTimeUnit":"ns","traceEvents":[)"));
+    CHECK(s.ends_with("]}\n"));
+    CHECK(count(s, R"("ph":"B")") == 2);
+    CHECK(count(s, R"("ph":"E")") == 2);
+    CHECK(count(s, "traced_CS (wait)\"") == 2);
+    CHECK(s.find(R"("ts":0.000)") != std::string::npos);
+}
+
+TEST_CASE("untagged call sites are told apart", "[tracing_policy]") {
+    using P = conc::tracing_policy<>;
+    P::reset();
+    conc::call_in_critical_section([] {});
+    conc::call_in_critical_section([] {});
+
+    auto const v = events<P>();
+    REQUIRE(v.size() == 6);
+    CHECK(v[0].second.name == v[3].second.name);
+    CHECK(v[0].second.tag == v[2].second.tag);
+    CHECK(v[0].second.tag != v[3].second.tag);
+
+    std::ostringstream os{};
+    P::write_chrome_trace(os);
+    auto const s = os.str();
+    CHECK(count(s, " #1 (wait)\"") == 2);
+    CHECK(count(s, " #2 (wait)\"") == 2);
+    CHECK(count(s, " #1\"") == 2);
+    CHECK(count(s, " #2\"") == 2);
+}
+
+TEST_CASE("contending threads are traced separately", "[tracing_policy]") {
+    using P = conc::tracing_policy<>;
+    P::reset();
+    constexpr auto iterations = 100u;
+    auto const work = [] {
+        for (auto i = 0u; i < iterations; ++i) {
+            conc::call_in_critical_section<traced_CS>(
+                [] { std::this_thread::yield(); });
+        }
+    };
+    std::thread t1{work};
+    std::thread t2{work};
+    t1.join();
+    t2.join();
+
+    auto const v = events<P>();
+    CHECK(v.size() == 2 * 3 * iterations);
+    std::set<std::size_t> tids{};
+    for (auto const &[tid, e] : v) {
+        tids.insert(tid);
+    }
+    CHECK(tids.size() == 2);
+}
+
+TEST_CASE("a full ring keeps the most recent events", "[tracing_policy]") {
+    using P = conc::tracing_policy<conc::standard_policy<>, 8>;
+    P::reset();
+    for (auto i = 0; i < 10; ++i) {
+        P::call_in_critical_section<traced_CS>([] {});
+    }
+    auto const v = events<P>();
+    CHECK(v.size() == 8);
+    CHECK(P::dropped() == 22);
+
+    // the first traced section was partly overwritten and is skipped
+    std::ostringstream os{};
+    P::write_chrome_trace(os);
+    auto const s = os.str();
+    CHECK(count(s, R"("ph":"B")") == 4);
+    CHECK(count(s, R"("ph":"E")") == 4);
+}
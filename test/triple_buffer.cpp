@@ -0,0 +1,99 @@
+#include <conc/triple_buffer.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+TEST_CASE("a triple buffer starts with its initial value", "[triple_buffer]") {
+    conc::triple_buffer<int> b{17};
+    CHECK(not b.has_update());
+    CHECK(b.read() == 17);
+}
+
+TEST_CASE("the consumer reads the latest published value",
+          "[triple_buffer]") {
+    conc::triple_buffer<int> b{};
+    b.write(1);
+    CHECK(b.has_update());
+    b.write(2);
+    CHECK(b.read() == 2);
+    CHECK(not b.has_update());
+    CHECK(b.read() == 2);
+}
+
+TEST_CASE("the producer can fill the buffer in place", "[triple_buffer]") {
+    conc::triple_buffer<std::array<int, 4>> b{};
+    b.write_buffer() = {1, 2, 3, 4};
+    CHECK(not b.update());
+    b.publish();
+    CHECK(b.update());
+    CHECK(b.current() == std::array{1, 2, 3, 4});
+    CHECK(not b.update());
+}
+
+TEST_CASE("the producer never overwrites the consumer's buffer",
+          "[triple_buffer]") {
+    conc::triple_buffer<int> b{};
+    b.write(1);
+    auto const &v = b.read();
+    for (auto i = 2; i < 10; ++i) {
+        b.write(i);
+    }
+    CHECK(v == 1);
+    CHECK(b.read() == 9);
+}
+
+namespace {
+struct snapshot {
+    std::uint64_t seq{};
+    std::array<std::uint64_t, 31> data{};
+
+    [[nodiscard]] auto consistent() const -> bool {
+        for (auto d : data) {
+            if (d != seq) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+} // namespace
+
+TEST_CASE("consumers see consistent, increasing snapshots",
+          "[triple_buffer]") {
+    constexpr auto writes = std::uint64_t{100'000};
+    conc::triple_buffer<snapshot> b{};
+    std::atomic<bool> done{};
+
+    std::thread producer{[&] {
+        for (auto i = std::uint64_t{1}; i <= writes; ++i) {
+            auto &s = b.write_buffer();
+            s.seq = i;
+            s.data.fill(i);
+            b.publish();
+        }
+        done = true;
+    }};
+
+    auto inconsistent = 0;
+    auto out_of_order = 0;
+    auto last = std::uint64_t{};
+    while (not done or b.has_update()) {
+        auto const &s = b.read();
+        if (not s.consistent()) {
+            ++inconsistent;
+        }
+        if (s.seq < last) {
+            ++out_of_order;
+        }
+        last = s.seq;
+    }
+    producer.join();
+
+    CHECK(inconsistent == 0);
+    CHECK(out_of_order == 0);
+    CHECK(b.read().seq == writes);
+}
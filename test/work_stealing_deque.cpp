@@ -0,0 +1,97 @@
+#include <conc/work_stealing_deque.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST_CASE("owner takes in LIFO order", "[work_stealing_deque]") {
+    conc::work_stealing_deque<int> d{};
+    CHECK(d.empty());
+    d.push(1);
+    d.push(2);
+    CHECK(d.size() == 2);
+    CHECK(d.take() == 2);
+    CHECK(d.take() == 1);
+    CHECK(d.take() == std::nullopt);
+    CHECK(d.empty());
+}
+
+TEST_CASE("thieves steal in FIFO order", "[work_stealing_deque]") {
+    conc::work_stealing_deque<int> d{};
+    d.push(1);
+    d.push(2);
+    CHECK(d.steal() == 1);
+    CHECK(d.steal() == 2);
+    CHECK(d.steal() == std::nullopt);
+}
+
+TEST_CASE("deque grows", "[work_stealing_deque]") {
+    conc::work_stealing_deque<int> d{2};
+    for (auto i = 0; i < 100; ++i) {
+        d.push(i);
+    }
+    CHECK(d.size() == 100);
+    CHECK(d.steal() == 0);
+    for (auto i = 99; i > 0; --i) {
+        CHECK(d.take() == i);
+    }
+    CHECK(d.empty());
+}
+
+TEST_CASE("deque wraps around", "[work_stealing_deque]") {
+    conc::work_stealing_deque<int> d{4};
+    for (auto i = 0; i < 100; ++i) {
+        d.push(i);
+        d.push(i);
+        CHECK(d.steal() == i);
+        CHECK(d.take() == i);
+    }
+    CHECK(d.empty());
+}
+
+TEST_CASE("every element is taken or stolen exactly once",
+          "[work_stealing_deque]") {
+    constexpr auto N = 100'000;
+    constexpr auto thieves = 3u;
+    conc::work_stealing_deque<std::uint32_t> d{16};
+    std::vector<std::atomic<std::uint32_t>> seen(N);
+    std::atomic<bool> done{};
+
+    std::array<std::thread, thieves> threads{};
+    for (auto &t : threads) {
+        t = std::thread{[&] {
+            while (not done or not d.empty()) {
+                if (auto const x = d.steal()) {
+                    ++seen[*x];
+                }
+            }
+        }};
+    }
+
+    for (auto i = 0u; i < N; ++i) {
+        d.push(i);
+        if (i % 3 == 0) {
+            if (auto const x = d.take()) {
+                ++seen[*x];
+            }
+        }
+    }
+    while (auto const x = d.take()) {
+        ++seen[*x];
+    }
+    done = true;
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    auto all_once = true;
+    for (auto const &s : seen) {
+        all_once = all_once and s == 1;
+    }
+    CHECK(all_once);
+}
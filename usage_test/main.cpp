@@ -1,5 +1,12 @@
+#include <conc/async.hpp>
 #include <conc/atomic.hpp>
+#include <conc/atomic_fallback.hpp>
+#include <conc/atomic_wrapper.hpp>
+#include <conc/barrier.hpp>
 #include <conc/concurrency.hpp>
+#include <conc/once.hpp>
+#include <conc/refcount.hpp>
+#include <conc/triple_buffer.hpp>
 
 #if __STDC_HOSTED__ == 0
 extern "C" auto main() -> int;